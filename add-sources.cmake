@@ -31,6 +31,7 @@ set(DOCUMENT_FILES
 set(EXPORTERS_FILES
     ${LOMSE_SRC_DIR}/exporters/lomse_ldp_exporter.cpp
     ${LOMSE_SRC_DIR}/exporters/lomse_lmd_exporter.cpp
+    ${LOMSE_SRC_DIR}/exporters/lomse_midi_exporter.cpp
     ${LOMSE_SRC_DIR}/exporters/lomse_mnx_exporter.cpp
     ${LOMSE_SRC_DIR}/exporters/lomse_mxl_exporter.cpp
 )
@@ -139,6 +140,7 @@ set(INTERNAL_MODEL_FILES
     ${LOMSE_SRC_DIR}/internal_model/lomse_api_internal_model.cpp
     ${LOMSE_SRC_DIR}/internal_model/lomse_id_assigner.cpp
     ${LOMSE_SRC_DIR}/internal_model/lomse_im_algorithms.cpp
+    ${LOMSE_SRC_DIR}/internal_model/lomse_im_arena.cpp
     ${LOMSE_SRC_DIR}/internal_model/lomse_im_attributes.cpp
     ${LOMSE_SRC_DIR}/internal_model/lomse_im_factory.cpp
     ${LOMSE_SRC_DIR}/internal_model/lomse_im_figured_bass.cpp
@@ -204,6 +206,7 @@ set(PARSER_FILES
 set(RENDER_FILES
     ${LOMSE_SRC_DIR}/render/lomse_bitmap_drawer.cpp
     ${LOMSE_SRC_DIR}/render/lomse_calligrapher.cpp
+    ${LOMSE_SRC_DIR}/render/lomse_display_list.cpp
     ${LOMSE_SRC_DIR}/render/lomse_font_freetype.cpp
     ${LOMSE_SRC_DIR}/render/lomse_font_storage.cpp
     ${LOMSE_SRC_DIR}/render/lomse_renderer.cpp
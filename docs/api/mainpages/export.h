@@ -49,5 +49,17 @@ Exporting in LDP format is done in the same way, but using the LdpExporter objec
     }
 @endcode
 
-*/
+Playback of an score can be exported as a Standard MIDI File by using the MidiExporter object. The exporter resolves repetitions, voltas and other jumps in the same way as the ScorePlayer, but without waiting for real time, so that an score is rendered in a few milliseconds. In this case Lomse writes the file. Example:
 
+@code
+    MidiExporter exporter(m_libraryScope);
+    exporter.set_tempo(90);             //quarter notes per minute
+    exporter.set_metronome(true);       //add a track with metronome clicks
+    AScore score = ...
+    if (!exporter.save_midi_file(score, path + "score.mid"))
+        std::cout << "file error write" << endl;
+@endcode
+
+Method MidiExporter::get_midi() returns the file content, instead of writing it, for applications that prefer to manage the file by themselves.
+
+*/
@@ -57,6 +57,8 @@ For playing back an score your application has just to define a class, derived f
 
 Sound events will be sent, directly, to your @c MyMidiServer class just by invoking any of the virtual methods. Invocation of these methods is done in real time, that is, lomse will determine the exact time at which a note on / note off has to take place, and will invoke the respective method, ``note_on()`` or ``note_off()``, at the appropriate time. This implies that your midi server implementation is only responsible for generating or stopping sounds when requested, and no time computations are needed.
 
+All sounds that must start or stop at the same time are sent together, by invoking virtual method ``send_messages()``. Its default implementation invokes ``voice_change()``, ``note_on()`` or ``note_off()`` for each sound, so overriding it is optional. Override it if your MIDI server can send all of them at once, e.g. as a single MIDI packet.
+
 Lomse does not impose any restriction about how to generate sounds other than low latency. Perhaps, the simpler method to generate sounds is to rely on the MIDI synthesizer of the PC sound card.
     
 @attention As playback is a real-time task, your code must return quickly. If it needs to do some significant amount of work then you must schedule this work asynchronously, for example by posting a windows message, or you should use a separate thread. Your application should not retain control for much time as this would result in freezing lomse playback thread.
@@ -10,6 +10,10 @@
 #ifndef __LOMSE_ANALYSER_H__
 #define __LOMSE_ANALYSER_H__
 
+#include <new>
+#include <utility>
+#include <vector>
+
 namespace lomse
 {
 
@@ -25,6 +29,45 @@ public:
 
 };
 
+//---------------------------------------------------------------------------------------
+// ElementAnalysersMemory: memory for the element analysers.
+// Analysing a tree requires to create and delete an element analyser for each node,
+// and the analysis is recursive. To avoid a heap allocation for each node, the
+// analysers are constructed in a buffer associated to the nesting level, and the
+// buffer is reused for all the nodes at that level. Analysers must be released in
+// reverse order of creation.
+class ElementAnalysersMemory
+{
+protected:
+    std::vector<void*> m_buffers;
+    int m_level;
+
+public:
+    ElementAnalysersMemory();
+    ~ElementAnalysersMemory();
+
+    enum { k_buffer_size = 1024, };
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(sizeof(T) <= k_buffer_size, "Analyser larger than buffer size");
+        return new (next_buffer()) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    void release(T* pAnalyser)
+    {
+        pAnalyser->~T();
+        --m_level;
+    }
+
+    inline void reset() { m_level = 0; }
+
+protected:
+    void* next_buffer();
+};
+
 
 }   //namespace lomse
 
@@ -265,8 +265,13 @@ struct Rectangle
     }
 
 
-//    // return true if the rectangles have a non empty intersection
-//    bool intersects(const Rectangle& rect) const;
+    // return true if the rectangles overlap or touch. Rectangles with zero
+    // width or height are not considered empty
+    bool intersects(const Rectangle& rect) const
+    {
+        return !(rect.right() < x || rect.x > right()
+                 || rect.bottom() < y || rect.y > bottom());
+    }
 };
 
 //---------------------------------------------------------------------------------------
@@ -146,6 +146,11 @@ public:
     void line_with_markers(UPoint start, UPoint end, LUnits width,
                            ELineCap startCap, ELineCap endCap) override;
 
+    // filled rectangles
+    bool accepts_filled_rectangles() const override { return true; }
+    void filled_rectangle(LUnits left, LUnits top, LUnits right, LUnits bottom,
+                          Color color) override;
+
 
     // Attribute setting functions.
     void fill(Color color) override;
@@ -243,6 +248,14 @@ public:
     unsigned get_rendering_buffer_width() const { return m_bufWidth; };
     unsigned get_rendering_buffer_height() const { return m_bufHeight; };
 
+    //Support for incremental repaint. The buffer content can be moved and then only
+    //the uncovered area rendered again. Coordinates are relative to the view area.
+    bool is_view_area_full_buffer() const;
+    void scroll_view_area(int dx, int dy);
+    void begin_partial_render(Pixels x1, Pixels y1, Pixels x2, Pixels y2,
+                              Color bgcolor);
+    void end_partial_render();
+
 
 protected:
     void push_attr();
@@ -250,6 +263,7 @@ protected:
     PathAttributes& cur_attr();
     void render_existing_paths();
     void delete_paths();
+    void use_font_storage_for_this_thread();
 
 };
 
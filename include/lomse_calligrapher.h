@@ -52,6 +52,8 @@ public:
     void draw_glyph(double x, double y, unsigned int ch, Color color, double scale);
     void draw_glyph_rotated(double x, double y, unsigned int ch, Color color, double scale, double rotation);
 
+    inline void set_font_storage(FontStorage* fonts) { m_pFonts = fonts; }
+
 protected:
     void draw_glyph(double x, double y, unsigned int ch, Color color);
     void set_scale(double scale);
@@ -297,6 +297,16 @@ private:
     UndoStack   m_stack;                    //stack of executed commands
     std::string m_error;
 
+    //checkpoints: document state after executing the first n commands in the stack.
+    //Undo of replay-from-start commands replays only from the nearest checkpoint
+    std::list< std::pair<size_t, DocModel*> > m_checkpoints;
+    int         m_checkpointCommands = 20;  //take a checkpoint every n commands
+    long        m_checkpointMillisecs = 500;    //or when replay time exceeds this
+    int         m_maxCheckpoints = 10;      //max. number of checkpoints to keep
+    int         m_cmdsSinceCheckpoint = 0;
+    double      m_replayTime = 0.0;         //millisecs to replay commands since
+                                            //last checkpoint
+
 public:
     /// Constructor
     DocCommandExecuter(Document* target);
@@ -334,6 +344,29 @@ public:
     /// Returns the number of undo/redo elements in the undo/redo stack.
     virtual size_t undo_stack_size() { return m_stack.size(); }
 
+    //checkpoints
+    /** Commands using the replay-from-start undo policy are undone by restoring a
+        saved copy of the document and replaying all previous commands. To bound
+        undo time, a copy of the document (a checkpoint) is saved periodically and
+        undo replays only the commands executed after the nearest checkpoint.
+
+        @param numCommands A checkpoint is taken after executing this number of
+            commands. Value 0 disables checkpoints based on number of commands.
+        @param milliseconds A checkpoint is taken when the time required to replay
+            the commands executed after the last checkpoint exceeds this value.
+            Value 0 disables checkpoints based on time.
+        @param maxCheckpoints Maximum number of checkpoints to keep. When this limit
+            is reached the oldest checkpoint is discarded. Value 0 disables
+            checkpoints.
+
+        By default, a checkpoint is taken every 20 commands or every 500 ms of
+        replay time, and a maximum of 10 checkpoints are kept.
+    */
+    void set_checkpoints_policy(int numCommands, long milliseconds, int maxCheckpoints);
+
+    /// Returns the number of checkpoints currently saved.
+    inline size_t num_checkpoints() { return m_checkpoints.size(); }
+
 protected:
     friend class DocCmdComposite;
     void update_cursor(DocCursor* pCursor, DocCommand* pCmd);
@@ -342,6 +375,10 @@ protected:
     void replay_until(UndoElement* pUE, DocCursor* pCursor, SelectionSet* pSelection);
     void replay_command(UndoElement* pUE, DocCursor* pCursor, SelectionSet* pSelection);
 
+    void save_checkpoint_if_needed(double millisecs);
+    void delete_checkpoints_after(size_t numCmds);
+    void delete_all_checkpoints();
+
 };
 
 //---------------------------------------------------------------------------------------
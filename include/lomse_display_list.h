@@ -0,0 +1,271 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#ifndef __LOMSE_DISPLAY_LIST_H__        //to avoid nested includes
+#define __LOMSE_DISPLAY_LIST_H__
+
+#include "lomse_drawer.h"
+
+//std
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lomse
+{
+
+///@cond INTERNALS
+//excluded from public API. Only for internal use.
+
+//---------------------------------------------------------------------------------------
+/** %DisplayList is a compact recording of the drawing commands generated by the
+    objects in a document page. Once recorded, the page can be drawn again by replaying
+    the commands on any Drawer, without traversing the graphic model.
+
+    Commands are stored in contiguous buffers: a byte per command and its numeric
+    arguments (coordinates, colors, indexes to strings) in a vector of doubles. The
+    commands are grouped by the graphic object that generated them, so that objects
+    outside the visible area can be skipped when replaying.
+
+    A display list is only valid for the rendering options used when recording it
+    and for drawers with the same capabilities (see is_valid_for()).
+*/
+class DisplayList
+{
+public:
+    //commands
+    enum EDisplayCommand
+    {
+        k_begin_path = 0,
+        k_end_path,
+        k_close_path,
+        k_add_path,
+        k_move_to,
+        k_move_to_rel,
+        k_line_to,
+        k_line_to_rel,
+        k_hline_to,
+        k_hline_to_rel,
+        k_vline_to,
+        k_vline_to_rel,
+        k_quadratic_bezier,
+        k_quadratic_bezier_rel,
+        k_smooth_quadratic_bezier,
+        k_smooth_quadratic_bezier_rel,
+        k_cubic_bezier,
+        k_cubic_bezier_rel,
+        k_smooth_cubic_bezier,
+        k_smooth_cubic_bezier_rel,
+        k_rect,
+        k_circle,
+        k_line,
+        k_polygon,
+        k_line_with_markers,
+        k_filled_rectangle,
+        k_fill,
+        k_fill_none,
+        k_stroke,
+        k_stroke_none,
+        k_stroke_width,
+        k_gradient_color,
+        k_gradient_start_color,
+        k_fill_linear_gradient,
+        k_select_font,
+        k_set_text_color,
+        k_draw_text,
+        k_draw_wtext,
+        k_draw_glyph,
+        k_draw_glyph_rotated,
+        k_draw_bitmap,
+        k_render,
+        k_start_simple_notation,
+        k_start_composite_notation,
+        k_end_composite_notation,
+    };
+
+protected:
+    //the commands generated by one graphic object
+    struct DisplayObject
+    {
+        URect bounds;
+        bool fAlwaysVisible;
+        size_t iCommand;        //index to first command
+        size_t iValue;          //index to first value
+    };
+
+    //bitmaps are copied, as the image of a shape could be replaced or deleted
+    //while the display list exists
+    struct DisplayBitmap
+    {
+        std::vector<unsigned char> pixels;
+        unsigned width;
+        unsigned height;
+        int stride;
+    };
+
+    std::vector<unsigned char> m_commands;
+    std::vector<double> m_values;
+    std::vector<std::string> m_strings;
+    std::vector<std::wstring> m_wstrings;
+    std::vector<DisplayBitmap> m_bitmaps;
+    std::vector<DisplayObject> m_objects;
+
+    //recording conditions
+    RenderOptions m_options;
+    bool m_fFilledRectangles;
+    bool m_fIdClass;
+
+public:
+    DisplayList(Drawer* pDrawer, const RenderOptions& opt);
+    ~DisplayList() {}
+
+    /** Returns @TRUE if replaying this display list on the given Drawer, with the
+        given options, generates the same output as drawing the objects.  */
+    bool is_valid_for(Drawer* pDrawer, const RenderOptions& opt) const;
+
+    /** Sends the recorded commands to the Drawer. Objects that are not visible
+        with the given options are skipped. */
+    void replay(Drawer* pDrawer, RenderOptions& opt) const;
+
+    //recording
+    void start_object(const URect& bounds);
+    inline void add_command(EDisplayCommand cmd) { m_commands.push_back((unsigned char)cmd); }
+    inline void add_value(double value) { m_values.push_back(value); }
+    void add_color(Color color);
+    void add_string(const std::string& str);
+    void add_wstring(const std::wstring& str);
+    void add_bitmap(RenderingBuffer& bmap);
+
+    //info
+    inline size_t num_commands() const { return m_commands.size(); }
+    inline size_t num_objects() const { return m_objects.size(); }
+    size_t memory_used() const;
+
+protected:
+    void replay_commands(Drawer* pDrawer, size_t iCmd, size_t iEnd, size_t iValue) const;
+    static Color to_color(double value);
+};
+
+typedef std::shared_ptr<DisplayList>  SpDisplayList;
+
+
+//---------------------------------------------------------------------------------------
+/** %RecordingDrawer: a Drawer that does not draw anything but records all received
+    commands in a DisplayList.
+
+    Capabilities (e.g. accepts_filled_rectangles()) and the conversion between device
+    and model units are taken from the Drawer for which the commands are recorded.
+*/
+class RecordingDrawer : public Drawer
+{
+protected:
+    Drawer* m_pTarget;
+    DisplayList* m_pList;
+
+public:
+    RecordingDrawer(Drawer* pTarget, DisplayList* pList);
+    virtual ~RecordingDrawer() {}
+
+    // SVG path commands
+    void begin_path() override;
+    void end_path() override;
+    void close_path() override;
+    void add_path(VertexSource& vs, unsigned path_id = 0, bool solid_path = true) override;
+    void move_to(double x, double y) override;
+    void move_to_rel(double x, double y) override;
+    void line_to(double x,  double y) override;
+    void line_to_rel(double x,  double y) override;
+    void hline_to(double x) override;
+    void hline_to_rel(double x) override;
+    void vline_to(double y) override;
+    void vline_to_rel(double y) override;
+    void quadratic_bezier(double x1, double y1, double x, double y) override;
+    void quadratic_bezier_rel(double x1, double y1, double x, double y) override;
+    void quadratic_bezier(double x, double y) override;
+    void quadratic_bezier_rel(double x, double y) override;
+    void cubic_bezier(double x1, double y1, double x2, double y2,
+                      double x, double y) override;
+    void cubic_bezier_rel(double x1, double y1, double x2, double y2,
+                          double x, double y) override;
+    void cubic_bezier(double x2, double y2, double x, double y) override;
+    void cubic_bezier_rel(double x2, double y2, double x, double y) override;
+
+    // SVG basic shapes
+    void rect(UPoint pos, USize size, LUnits radius) override;
+    void circle(LUnits xCenter, LUnits yCenter, LUnits radius) override;
+    void line(LUnits x1, LUnits y1, LUnits x2, LUnits y2,
+              LUnits width, ELineEdge nEdge=k_edge_normal) override;
+    void polygon(int n, UPoint points[]) override;
+    void line_with_markers(UPoint start, UPoint end, LUnits width,
+                           ELineCap startCap, ELineCap endCap) override;
+
+    // filled rectangles
+    bool accepts_filled_rectangles() const override;
+    void filled_rectangle(LUnits left, LUnits top, LUnits right, LUnits bottom,
+                          Color color) override;
+
+    // attributes
+    void fill(Color color) override;
+    void fill_none() override;
+    void stroke(Color color) override;
+    void stroke_none() override;
+    void stroke_width(double w) override;
+    void gradient_color(Color c1, Color c2, double start, double stop) override;
+    void gradient_color(Color c1, double start, double stop) override;
+    void fill_linear_gradient(LUnits x1, LUnits y1, LUnits x2, LUnits y2) override;
+
+    // text
+    bool select_font(const std::string& language,
+                     const std::string& fontFile,
+                     const std::string& fontName, double height,
+                     bool fBold=false, bool fItalic=false) override;
+    void set_text_color(Color color) override;
+    int draw_text(double x, double y, const std::string& str) override;
+    int draw_text(double x, double y, const wstring& str) override;
+    void draw_glyph(double x, double y, unsigned int ch) override;
+    void draw_glyph_rotated(double x, double y, unsigned int ch, double rotation) override;
+
+    // bitmaps
+    void draw_bitmap(RenderingBuffer& bmap, bool hasAlpha,
+                     Pixels srcX1, Pixels srcY1, Pixels srcX2, Pixels srcY2,
+                     LUnits dstX1, LUnits dstY1, LUnits dstX2, LUnits dstY2,
+                     EResamplingQuality resamplingMode,
+                     double alpha=1.0) override;
+
+    // settings. Shift and transformation are not recorded: they are defined by
+    // the Drawer used for replaying
+    void set_shift(LUnits UNUSED(x), LUnits UNUSED(y)) override {}
+    void remove_shift() override {}
+    void render() override;
+    void set_affine_transformation(TransAffine& UNUSED(transform)) override {}
+    void reset(Color UNUSED(bgcolor)) override {}
+
+    // device - model units conversion
+    void device_point_to_model(double* x, double* y) const override;
+    void model_point_to_device(double* x, double* y) const override;
+    LUnits device_units_to_model(double value) const override;
+    double model_to_device_units(LUnits value) const override;
+
+    // shapes info
+    void start_simple_notation(std::string id, std::string classname) override;
+    void start_composite_notation(std::string id, std::string classname) override;
+    void end_composite_notation() override;
+    void start_object(const URect& bounds) override;
+
+    // info
+    bool is_ready() const override { return true; }
+    bool accepts_id_class() const override;
+
+};
+
+///@endcond
+
+}   //namespace lomse
+
+#endif    // __LOMSE_DISPLAY_LIST_H__
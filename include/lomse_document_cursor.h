@@ -481,6 +481,7 @@ protected:
     //support: related to time info
     void p_determine_total_duration();
     void p_find_start_of_measure_and_time_signature();
+    bool p_beat_duration_from_measures_table();
 
     //support: point_to
     void p_move_iterator_to(ImoId id);
@@ -113,6 +113,11 @@ struct RenderOptions
     bool read_only_mode;
     int highlighted_voice;          //0 for none
 
+    //culling: when use_clip_rect is true only boxes and shapes intersecting
+    //clip_rect (in page coordinates) are drawn
+    bool use_clip_rect;
+    URect clip_rect;
+
 
     RenderOptions()
         : draw_anchor_objects(false)
@@ -138,6 +143,7 @@ struct RenderOptions
         , draw_voices_coloured(false)
         , read_only_mode(true)
         , highlighted_voice(0)                  //0=none, 1..n= voice 1..n
+        , use_clip_rect(false)
     {
         boxes.reset();
 
@@ -168,6 +174,11 @@ struct RenderOptions
         return boxes[type];
     }
 
+    bool is_visible(const URect& bounds)
+    {
+        return !use_clip_rect || clip_rect.intersects(bounds);
+    }
+
 
 };
 
@@ -481,6 +492,28 @@ public:
     //@}    //SVG basic shapes commands
 
 
+    /** @name Filled rectangles
+        Staff lines, stems, barlines and ledger lines are rectangles axis-aligned with
+        the user coordinate system. Some drawers can render them much faster than
+        a general path.
+    */
+    //@{
+
+    /** Returns @TRUE if the %Drawer renders filled rectangles directly, without
+        using a path. In this case, shapes should use filled_rectangle() for drawing
+        axis-aligned lines. Default implementation returns @FALSE.
+    */
+    virtual bool accepts_filled_rectangles() const { return false; }
+
+    /** Draw a rectangle, axis-aligned with the current user coordinate system, filled
+        with the given color and without stroke. The rectangle is drawn after any
+        previously defined path. Default implementation uses a new path.
+    */
+    virtual void filled_rectangle(LUnits left, LUnits top, LUnits right, LUnits bottom,
+                                  Color color);
+    //@}    //Filled rectangles
+
+
 
     /** @name Attribute setting methods
         Define the attributes for current open path.
@@ -768,6 +801,14 @@ public:
         element has finished.
     */
     virtual void end_composite_notation() {}
+
+    /** This method is used to inform the Drawer that the drawing of a new graphic
+        object (a shape or the border of a box) is going to start.
+        @param bounds  The bounds of the object, in model units. Objects outside
+            the visible area are not drawn, but a Drawer that records the commands
+            (see RecordingDrawer) needs this information for later culling.
+    */
+    virtual void start_object(const URect& UNUSED(bounds)) {}
     //@}    //Shapes info
 
 
@@ -800,6 +841,9 @@ public:
 
     /** Returns @TRUE if the %Drawer accepts 'id' and 'class' information */
     virtual bool accepts_id_class() const { return false; }
+
+    /** Returns the library Scope object associated to this %Drawer. */
+    inline LibraryScope& get_library_scope() { return m_libraryScope; }
     //@}    //Other methods
 
 };
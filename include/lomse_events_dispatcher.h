@@ -14,8 +14,11 @@
 #include "lomse_injectors.h"
 #include "lomse_events.h"
 
-//TODO: For now, direct invocation without enqueuing the event in the thread.
-#define LOMSE_DIRECT_INVOCATION     1       //1=do not use events thread
+//Direct invocation, without enqueuing the event in the thread, unless the library
+//is built with option LOMSE_DIRECT_INVOCATION=OFF (see lomse_config.h)
+#ifndef LOMSE_DIRECT_INVOCATION
+    #define LOMSE_DIRECT_INVOCATION     1       //1=do not use events thread
+#endif
 
 
 #if (LOMSE_DIRECT_INVOCATION == 1)
@@ -43,6 +46,7 @@ public:
 #else
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <queue>
 
 namespace lomse
@@ -62,17 +66,22 @@ typedef std::unique_lock<std::mutex> QueueLock;
 // EventsDispatcher
 //  Class to manage the event-dispatch loop.
 //  This class is a singleton maintained in Lomse LibraryScope object
+//  The events thread sleeps until an event is posted, so events are delivered
+//  without polling delays. A visual tracking event is merged into the previous
+//  one when it is still pending for the same observer and interactor, so that
+//  the observer receives a single event with all the pending sub-events.
 class EventsDispatcher
 {
 protected:
     EventsThread* m_pThread = nullptr;        //execution thread
     QueueMutex m_mutex;             //to control queue access
+    std::condition_variable m_wakeUp;   //signaled when an event is posted or on stop
     bool m_fStopLoop = false;
     std::queue< std::pair<SpEventInfo, Observer*> > m_events;
 
 public:
     EventsDispatcher() {}
-;
+    ~EventsDispatcher();
 
     void start_events_loop();
     void stop_events_loop();
@@ -80,11 +89,9 @@ public:
     void post_event(Observer* pObserver, SpEventInfo pEvent);
 
 protected:
-    inline bool stop_event_received() { return m_fStopLoop; }
     void run_events_loop();
     void thread_main();
-    inline bool pending_events() { return !m_events.empty(); }
-    void dispatch_next_event();
+    bool coalesce_with_last_event(Observer* pObserver, SpEventInfo pEvent);
 
 };
 #endif
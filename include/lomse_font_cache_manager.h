@@ -89,6 +89,7 @@ struct glyph_cache
         block_allocator m_allocator;
         glyph_cache**   m_glyphs[256];
         char*           m_font_signature;
+        unsigned        m_num_bytes;        //approx. memory used by cached glyphs
 
     public:
         enum block_size_e { block_size = 16384-16 };
@@ -97,6 +98,7 @@ struct glyph_cache
         font_cache()
             : m_allocator(block_size)
             , m_font_signature(nullptr)
+            , m_num_bytes(block_size)
         {
         }
 
@@ -115,6 +117,9 @@ struct glyph_cache
             return strcmp(font_signature, m_font_signature) == 0;
         }
 
+        //--------------------------------------------------------------------
+        unsigned memory_used() const { return m_num_bytes; }
+
         //--------------------------------------------------------------------
         const glyph_cache* find_glyph(unsigned glyph_code) const
         {
@@ -142,6 +147,7 @@ struct glyph_cache
                     (glyph_cache**)m_allocator.allocate(sizeof(glyph_cache*) * 256,
                                                         sizeof(glyph_cache*));
                 memset(m_glyphs[msb], 0, sizeof(glyph_cache*) * 256);
+                m_num_bytes += unsigned(sizeof(glyph_cache*) * 256);
             }
 
             unsigned lsb = glyph_code & 0xFF;
@@ -158,6 +164,7 @@ struct glyph_cache
             glyph->bounds             = bounds;
             glyph->advance_x          = advance_x;
             glyph->advance_y          = advance_y;
+            m_num_bytes += unsigned(sizeof(glyph_cache)) + data_size;
             return m_glyphs[msb][lsb] = glyph;
         }
     };
@@ -168,14 +175,20 @@ struct glyph_cache
 
 
 //---------------------------------------------------------------------------------------
-// font_cache_pool: fonts?
+// font_cache_pool: the glyph caches for the used fonts.
+// Each cache is identified by the font signature, that includes the font, its size,
+// the rendering options and the transform (the scale for current zoom). Caches are
+// kept in least recently used order, so that caches for recently used zoom levels
+// survive. The least recently used ones are discarded when there are too many
+// caches or when the memory used by the glyphs exceeds the budget.
 
 class font_cache_pool
 {
 private:
-    font_cache** m_fonts;
+    font_cache** m_fonts;           //ordered from least to most recently used
     unsigned     m_max_fonts;
     unsigned     m_num_fonts;
+    unsigned     m_max_bytes;       //memory budget for all glyph caches
     font_cache*  m_cur_font;
 
 public:
@@ -187,14 +200,15 @@ public:
         {
             obj_allocator<font_cache>::deallocate(m_fonts[i]);
         }
-        pod_allocator<font_cache*>::deallocate(m_fonts, m_max_fonts);
+        pod_allocator<font_cache*>::deallocate(m_fonts, m_max_fonts + 1);
     }
 
     //--------------------------------------------------------------------
-    font_cache_pool(unsigned max_fonts=32) :
-        m_fonts(pod_allocator<font_cache*>::allocate(max_fonts)),
+    font_cache_pool(unsigned max_fonts=256, unsigned max_bytes=16*1024*1024) :
+        m_fonts(pod_allocator<font_cache*>::allocate(max_fonts + 1)),
         m_max_fonts(max_fonts),
         m_num_fonts(0),
+        m_max_bytes(max_bytes),
         m_cur_font(nullptr)
     {}
 
@@ -205,29 +219,39 @@ public:
         int idx = find_font(font_signature);
         if(idx >= 0)
         {
+            font_cache* fc = m_fonts[idx];
             if(reset_cache)
             {
-                obj_allocator<font_cache>::deallocate(m_fonts[idx]);
-                m_fonts[idx] = obj_allocator<font_cache>::allocate();
-                m_fonts[idx]->signature(font_signature);
+                obj_allocator<font_cache>::deallocate(fc);
+                fc = obj_allocator<font_cache>::allocate();
+                fc->signature(font_signature);
             }
-            m_cur_font = m_fonts[idx];
+            //move it to the most recently used position
+            memmove(m_fonts + idx,
+                    m_fonts + idx + 1,
+                    (m_num_fonts - idx - 1) * sizeof(font_cache*));
+            m_fonts[m_num_fonts - 1] = fc;
         }
         else
         {
-            if(m_num_fonts >= m_max_fonts)
-            {
-                obj_allocator<font_cache>::deallocate(m_fonts[0]);
-                memmove(m_fonts,
-                        m_fonts + 1,
-                        (m_max_fonts - 1) * sizeof(font_cache*));
-                m_num_fonts = m_max_fonts - 1;
-            }
             m_fonts[m_num_fonts] = obj_allocator<font_cache>::allocate();
             m_fonts[m_num_fonts]->signature(font_signature);
-            m_cur_font = m_fonts[m_num_fonts];
             ++m_num_fonts;
         }
+        m_cur_font = m_fonts[m_num_fonts - 1];
+        discard_least_recently_used();
+    }
+
+    //--------------------------------------------------------------------
+    unsigned num_fonts() const { return m_num_fonts; }
+
+    //--------------------------------------------------------------------
+    unsigned memory_used() const
+    {
+        unsigned bytes = 0;
+        for(unsigned i = 0; i < m_num_fonts; ++i)
+            bytes += m_fonts[i]->memory_used();
+        return bytes;
     }
 
     //--------------------------------------------------------------------
@@ -269,14 +293,35 @@ public:
     //--------------------------------------------------------------------
     int find_font(const char* font_signature)
     {
-        unsigned i;
-        for(i = 0; i < m_num_fonts; i++)
+        //most recently used fonts are the most likely to be requested
+        for(int i = int(m_num_fonts) - 1; i >= 0; --i)
         {
-            if(m_fonts[i]->font_is(font_signature)) return int(i);
+            if(m_fonts[i]->font_is(font_signature)) return i;
         }
         return -1;
     }
 
+private:
+    //--------------------------------------------------------------------
+    void discard_least_recently_used()
+    {
+        //current font, the most recently used, is never discarded
+        unsigned bytes = memory_used();
+        unsigned num = 0;
+        while(m_num_fonts - num > 1
+              && (m_num_fonts - num > m_max_fonts || bytes > m_max_bytes))
+        {
+            bytes -= m_fonts[num]->memory_used();
+            obj_allocator<font_cache>::deallocate(m_fonts[num]);
+            ++num;
+        }
+        if(num > 0)
+        {
+            m_num_fonts -= num;
+            memmove(m_fonts, m_fonts + num, m_num_fonts * sizeof(font_cache*));
+        }
+    }
+
 };
 
 
@@ -324,8 +369,9 @@ private:
 
 public:
     //--------------------------------------------------------------------
-    font_cache_manager(font_engine_type& engine, unsigned max_fonts=32) :
-        m_fonts(max_fonts),
+    font_cache_manager(font_engine_type& engine, unsigned max_fonts=256,
+                       unsigned max_bytes=16*1024*1024) :
+        m_fonts(max_fonts, max_bytes),
         m_engine(engine),
         m_change_stamp(-1),
         m_dx(0.0),
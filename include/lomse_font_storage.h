@@ -28,6 +28,7 @@
 
 //std
 #include <string>
+#include <mutex>
 #include <map>
 using namespace std;
 
@@ -65,6 +66,24 @@ protected:
     bool    m_fFlip_y;
     EFontCacheType      m_fontCacheType;
     string m_fontFullName;
+    agg::trans_affine   m_transform;
+
+    int     m_numFontChanges;   //times the font has been selected in the engine
+
+    //last font requested to the FontSelector, to avoid repeating the search when
+    //the same font is selected again (e.g. for each glyph shape to draw). It is
+    //discarded when the font paths change
+    struct FontRequest
+    {
+        std::string language;
+        std::string fontFile;
+        std::string fontName;
+        bool fBold;
+        bool fItalic;
+        long fontPathsRevision;
+        std::string fullFile;
+    };
+    FontRequest m_lastRequest;
 
 public:
     FontStorage(LibraryScope* pLibScope);
@@ -76,6 +95,8 @@ public:
     inline double get_ascender() { return m_fontEngine.ascender(); }
     inline double get_descender() { return m_fontEngine.descender(); }
     inline const string& get_font_file() { return m_fontFullName; }
+    inline EFontCacheType get_font_cache_type() { return m_fontCacheType; }
+    inline int get_num_font_changes() { return m_numFontChanges; }     //for unit tests
 
     void set_font_size(double rPoints);
     void set_font_height(double rPoints);
@@ -111,13 +132,15 @@ public:
     inline Gary8Scanline& get_gray8_scanline() {
         return m_fontCacheManager.gray8_scanline();
     }
-    inline void set_transform(agg::trans_affine& mtx) {
-        m_fontEngine.transform(mtx);
-    }
+    void set_transform(agg::trans_affine& mtx);
 
 protected:
     bool set_font(const std::string& fontFullName, double height,
                   EFontCacheType type = k_raster_font_cache);
+    const std::string& find_font_file(const std::string& language,
+                                      const std::string& fontFile,
+                                      const std::string& fontName,
+                                      bool fBold, bool fItalic);
 
 };
 
@@ -129,6 +152,7 @@ class FontSelector
 protected:
     LibraryScope* m_pLibScope;
     std::map<string, string> m_cache;
+    std::mutex m_mutex;             //find_font() can be invoked from several threads
 
 public:
     FontSelector(LibraryScope* pLibScope) : m_pLibScope(pLibScope) {}
@@ -12,6 +12,9 @@
 
 #include "lomse_basic.h"
 
+#include <map>
+#include <mutex>
+
 namespace lomse
 {
 
@@ -892,20 +895,39 @@ enum EGlyphIndex
 
 };
 
+//---------------------------------------------------------------------------------------
+// GlyphMetrics: measurements of a music font glyph, for a font size
+struct GlyphMetrics
+{
+    URect bbox;             //bounding box, relative to the glyph origin
+    LUnits advance = 0.0f;  //horizontal advance
+};
+
 //---------------------------------------------------------------------------------------
 // Encapsulate access to glyphs table. A singleton with library scope
+//---------------------------------------------------------------------------------------
 class MusicGlyphs
 {
 protected:
     LibraryScope* m_pLibScope;
     const GlyphData* m_glyphs;
 
+    //metrics table, by font height and glyph code
+    std::map<std::pair<double, unsigned int>, GlyphMetrics> m_metrics;
+    long m_fontPathsRevision;   //font paths revision when the metrics were measured
+    std::mutex m_mutex;         //layout can be done in several threads
+
 public:
     MusicGlyphs(LibraryScope* pLibScope);
     ~MusicGlyphs() {}
 
     void update();
 
+    /** Returns the metrics of the music font glyph with code glyphCode, for the
+        given font height. The glyph is measured only the first time it is requested
+        and the result is saved for the next requests.   */
+    GlyphMetrics get_glyph_metrics(unsigned int glyphCode, double fontHeight);
+
     inline unsigned int glyph_code(int iGlyph) { return (*(m_glyphs+iGlyph)).GlyphChar; }
     inline std::string glyph_name(int iGlyph) { return (*(m_glyphs+iGlyph)).GlyphName; }
     inline LUnits glyph_offset(int UNUSED(iGlyph)) { return 0.0f; }
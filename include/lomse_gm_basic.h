@@ -18,6 +18,9 @@
 #include <list>
 #include <ostream>
 #include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 ///@cond INTERNALS
 namespace lomse
@@ -49,6 +52,7 @@ class Control;
 class ScoreStub;
 class GraphicModel;
 class GmMeasuresTable;
+class DisplayList;
 
 
 ///@cond INTERNALS
@@ -328,8 +332,8 @@ public:
     inline bool is_shape_word() { return m_objtype == k_shape_word; }
 
     //size
-    inline void set_width(LUnits width) { m_size.width = width; }
-    inline void set_height(LUnits height) { m_size.height = height; }
+    void set_width(LUnits width);
+    void set_height(LUnits height);
 
     //position
     void set_origin(UPoint& pos);
@@ -504,6 +508,10 @@ protected:
     LUnits m_uLeftMargin;
     LUnits m_uRightMargin;
 
+    //area covered by this box and all its content, for culling when drawing
+    URect m_drawBounds;
+    bool m_fDrawBoundsValid;
+
     GmoBox(int objtype, ImoObj* pCreatorImo);
     ~GmoBox() override;
 
@@ -564,6 +572,8 @@ public:
 
     //drawing
     virtual void on_draw(Drawer* pDrawer, RenderOptions& opt);
+    URect get_drawing_bounds();
+    void invalidate_drawing_bounds();
 
     //hit testing
     GmoBox* find_inner_box_at(LUnits x, LUnits y);
@@ -671,6 +681,25 @@ class GmoBoxDocPage : public GmoBox
 protected:
     int m_numPage;      //1..n
     std::list<GmoShape*> m_allShapes;		//contained shapes, ordered by layer and creation order
+    std::map<ImoObj*, GmoShape*> m_firstShapeForImo;    //first shape in m_allShapes for each creator
+
+    //uniform grid for locating shapes by position. It is built on demand and
+    //discarded when shapes are added or moved
+    bool m_fGridValid;
+    URect m_gridBounds;
+    LUnits m_cellWidth;
+    LUnits m_cellHeight;
+    int m_numCols;
+    int m_numRows;
+    std::vector<GmoShape*> m_gridShapes;            //same order than m_allShapes
+    std::vector< std::vector<int> > m_gridCells;    //indexes to m_gridShapes, ascending
+
+    //drawing commands for the page. Recorded when the page is drawn and discarded
+    //when the page content changes
+    std::shared_ptr<DisplayList> m_pDisplayList;
+    std::mutex m_displayListMutex;      //pages can be printed from several threads
+    std::atomic<bool> m_fDisplayListRecorded;
+    std::atomic<size_t> m_displayListMemory;    //bytes used by the display list
 
 public:
     ///@cond INTERNALS
@@ -700,10 +729,23 @@ public:
     void select_objects_in_rectangle(SelectionSet* selection, const URect& selRect,
                                      unsigned flags=0);
 
+    //spatial index
+    inline void invalidate_shapes_grid() { m_fGridValid = false; }
+
+    //display list
+    void draw_using_display_list(Drawer* pDrawer, RenderOptions& opt);
+    void invalidate_display_list();
+    inline DisplayList* get_display_list() { return m_pDisplayList.get(); }
+    void set_display_list(DisplayList* pList);     //for unit tests
+    inline size_t get_display_list_memory() { return m_displayListMemory; }
+
     ///@endcond
 
 protected:
     void draw_page_background(Drawer* pDrawer, RenderOptions& opt);
+    void build_shapes_grid();
+    int grid_col(LUnits x);
+    int grid_row(LUnits y);
 };
 
 //---------------------------------------------------------------------------------------
@@ -182,10 +182,19 @@ protected:
 
     //for printing (deprecated variable, to be removed when deprecated methods are removed)
     double           m_print_ppi;     //printer resolution in pixels per inch
+    TransAffine      m_printTransform;    //scale for printing, set in set_print_page_size()
 
     //options
     Color       m_backgroundColor;
 
+    //information about the last rendering of the graphic model, for reusing it
+    //when only the viewport origin has changed
+    bool        m_fBackgroundValid;
+    long        m_bgModelId;
+    long        m_bgRevision;
+    Pixels      m_bgVxOrg, m_bgVyOrg;
+    TransAffine m_bgTransform;
+
 public:
 ///@cond INTERNALS
 //excluded from public API because the View methods are managed from Interactor
@@ -230,7 +239,8 @@ public:
     void draw_dragged_image();
     void draw_selected_objects();
     void draw_handler(Handler* pHandler);
-    void set_background(Color color) { m_backgroundColor = color; }
+    void set_background(Color color) { m_backgroundColor = color; invalidate_background(); }
+    inline void invalidate_background() { m_fBackgroundValid = false; }
     ///@}    //Renderization related
 
 
@@ -432,6 +442,10 @@ public:
     virtual void set_print_page_size(Pixels width, Pixels height);
     void set_print_buffer(unsigned char* buf, unsigned width, unsigned height);
     virtual void print_page(int page, VPoint viewport);
+    virtual void print_pages(const std::vector<int>& pages,
+                             const std::vector<unsigned char*>& buffers,
+                             unsigned width, unsigned height, VPoint viewport,
+                             int numThreads=0);
 
     //Deprecated methods, to be removed when the method is removed from Interactor
     void set_print_buffer(RenderingBuffer* rbuf);
@@ -463,10 +477,15 @@ protected:
 
     virtual void draw_all();
     void draw_graphic_model();
+    bool update_render_options();
+    bool draw_graphic_model_incrementally();
+    void draw_area(BitmapDrawer* pDrawer, Pixels x1, Pixels y1, Pixels x2, Pixels y2);
+    void save_background_info();
     void draw_time_grid();
     void generate_paths();
+    void generate_paths(const VRect& area);
     virtual void collect_page_bounds() = 0;
-    void draw_visible_pages(int minPage, int maxPage);
+    void draw_visible_pages(int minPage, int maxPage, const VRect& area);
     URect get_page_bounds(int iPage);
     int find_page_at_point(LUnits x, LUnits y);
     bool shift_right_x_to_be_on_page(double* xLeft);
@@ -478,7 +497,7 @@ protected:
     void trimmed_rectangle_to_page_rectangles(list<PageRectangle*>* rectangles,
                                               double xLeft, double yTop,
                                               double xRight, double yBottom);
-    void determine_visible_pages(int* minPage, int* maxPage);
+    void determine_visible_pages(const VRect& area, int* minPage, int* maxPage);
     bool is_valid_viewport();
     void delete_rectangles(list<PageRectangle*>& rectangles);
     void layout_caret();
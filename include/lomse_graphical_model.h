@@ -14,6 +14,7 @@
 #include <list>
 #include <ostream>
 #include <map>
+#include <mutex>
 using namespace std;
 
 #include "lomse_basic.h"
@@ -165,6 +166,7 @@ protected:
     GmoBoxDocument* m_root;
     long m_modelId;
     bool m_modified;
+    long m_revision;        //incremented each time the model is modified
     map<ImoId, GmoBox*> m_imoToBox;
     map<ImoId, GmoShape*> m_imoToMainShape;
     map< pair<ImoId, ShapeId>, GmoShape*> m_imoToSecondaryShape;
@@ -172,6 +174,12 @@ protected:
     map<ImoId, ScoreStub*> m_scores;
     AreaInfo m_areaInfo;
 
+    //pages having a display list, most recently drawn first. Display lists for
+    //pages not recently drawn are discarded when the budget is exceeded
+    std::mutex m_displayListsMutex;
+    std::list<int> m_pagesWithDisplayList;
+    size_t m_displayListsBudget;        //bytes
+
 public:
 
     ///@cond INTERNALS
@@ -340,12 +348,14 @@ public:
     ///@cond INTERNALS
     //excluded from public API. Only for internal use.
 
-    inline void set_modified(bool value) { m_modified = value; }
+    inline void set_modified(bool value) { m_modified = value; if (value) ++m_revision; }
     inline bool is_modified() { return m_modified; }
     inline long get_model_id() { return m_modelId; }
+    inline long get_revision() { return m_revision; }
 
     //drawing
     void draw_page(int iPage, UPoint& origin, Drawer* pDrawer, RenderOptions& opt);
+    inline void set_display_lists_budget(size_t bytes) { m_displayListsBudget = bytes; }
     //void highlight_object(ImoStaffObj* pSO, bool value);
 
     //hit testing and related
@@ -374,6 +384,7 @@ public:
 
 protected:
     ScoreStub* get_stub_for(ImoId scoreId);
+    void keep_display_lists_within_budget(int iPage);
 
 };
 
@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#ifndef __LOMSE_IM_ARENA_H__
+#define __LOMSE_IM_ARENA_H__
+
+#include "lomse_build_options.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace lomse
+{
+
+//---------------------------------------------------------------------------------------
+/** %ImArena is a memory arena for the objects of an internal model (ImoObj and
+    AttrObj objects). Each DocModel owns an arena.
+
+    Objects are allocated in slots taken from big memory chunks, and when an object is
+    deleted its slot is saved for reuse by objects of similar size. This avoids
+    spreading the document over many small heap blocks.
+
+    The arena is destroyed when its owner has released it and all objects allocated in
+    the arena have been deleted. At that moment all chunks are released together.
+
+    Objects are allocated in the current arena for the thread, when there is one,
+    or in the heap otherwise. See ImArenaScope.
+
+    The arena has no mutex: objects of a DocModel must not be created or deleted
+    from several threads at the same time. When scores are structurized in parallel,
+    ModelBuilder serializes the ImFactory::inject() calls with a DocModelLock.
+*/
+class ImArena
+{
+protected:
+    std::vector<char*> m_chunks;
+    std::vector<void*> m_freeSlots;     //first free slot for each slot size
+    char* m_pNext = nullptr;            //first unused byte in last chunk
+    size_t m_available = 0;             //unused bytes in last chunk
+    size_t m_numObjects = 0;            //objects currently allocated
+    bool m_fOwned = true;
+
+public:
+    ImArena();
+    ~ImArena();
+
+    ImArena(const ImArena&) = delete;
+    ImArena& operator= (const ImArena&) = delete;
+
+    enum {
+        k_granularity = 16,             //slot sizes are multiple of this value
+        k_max_slot_size = 1024,         //bigger objects are allocated in the heap
+        k_chunk_size = 64 * 1024,
+    };
+
+    //owner
+    void release();
+
+    //allocation
+    void* allocate(size_t size);
+    void deallocate(void* p, size_t size);
+
+    //information
+    inline size_t num_objects() const { return m_numObjects; }
+    inline size_t num_chunks() const { return m_chunks.size(); }
+
+    //current arena for this thread
+    static ImArena* get_current();
+    static void set_current(ImArena* pArena);
+
+    //operators new and delete for internal model objects
+    static void* allocate_object(size_t size);
+    static void deallocate_object(void* p, size_t size);
+    static ImArena* get_arena_for(void* pObject);
+
+protected:
+    void add_chunk();
+
+};
+
+//---------------------------------------------------------------------------------------
+/** %ImArenaScope sets the current arena for this thread while the %ImArenaScope
+    object exists, and restores the previous one when it is destroyed.
+*/
+class ImArenaScope
+{
+protected:
+    ImArena* m_pPrevArena;
+
+public:
+    explicit ImArenaScope(ImArena* pArena)
+        : m_pPrevArena( ImArena::get_current() )
+    {
+        ImArena::set_current(pArena);
+    }
+    ~ImArenaScope() { ImArena::set_current(m_pPrevArena); }
+
+    ImArenaScope(const ImArenaScope&) = delete;
+    ImArenaScope& operator= (const ImArenaScope&) = delete;
+};
+
+//---------------------------------------------------------------------------------------
+// Macro to include in the root class of a hierarchy of internal model objects, to
+// allocate them in the current arena
+#if (LOMSE_ENABLE_IM_ARENA == 1)
+    #define LOMSE_IM_ARENA_ALLOCATION                                                   \
+        static void* operator new(size_t size) {                                        \
+            return ImArena::allocate_object(size);                                      \
+        }                                                                               \
+        static void operator delete(void* p, size_t size) {                             \
+            ImArena::deallocate_object(p, size);                                        \
+        }
+#else
+    #define LOMSE_IM_ARENA_ALLOCATION
+#endif
+
+
+}   //namespace lomse
+
+#endif      //__LOMSE_IM_ARENA_H__
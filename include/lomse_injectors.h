@@ -17,7 +17,9 @@
 #include "lomse_import_options.h"
 
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 
 namespace lomse
 {
@@ -82,7 +84,8 @@ protected:
     LomseDoorway* m_pDoorway;
     LomseDoorway* m_pNullDoorway;
     LdpFactory* m_pLdpFactory;
-    FontStorage* m_pFontStorage;
+    long m_scopeId;                     //to locate the FontStorage of each thread
+    std::recursive_mutex m_mutex;       //for lazy instantiation of shared objects
     FontSelector* m_pFontSelector;
     Metronome* m_pGlobalMetronome;
     EventsDispatcher* m_pDispatcher;
@@ -90,6 +93,7 @@ protected:
     std::string m_sMusicFontName;
     std::string m_sMusicFontPath;
     std::string m_sFontsPath;
+    std::atomic<long> m_fontPathsRevision;  //incremented when font paths change
     MusicGlyphs* m_pMusicGlyphs;
 
     //options
@@ -148,7 +152,9 @@ public:
     MusicGlyphs* get_glyphs_table();
     inline void set_default_fonts_path(const std::string& fontsPath) {
         m_sFontsPath = fontsPath;
+        ++m_fontPathsRevision;
     }
+    inline long get_font_paths_revision() { return m_fontPathsRevision; }
     void set_music_font(const std::string& fontFile, const std::string& fontName,
                         const std::string& path="");
     inline const std::string& get_music_font_name() { return m_sMusicFontName; }
@@ -217,6 +223,9 @@ public:
     }
     inline int get_trace_level_for_lines_breaker() { return m_traceLinesBreaker; }
 
+protected:
+    void delete_font_storage();
+
 };
 
 //---------------------------------------------------------------------------------------
@@ -1202,6 +1202,29 @@ public:
     */
     virtual void print_page(int page, VPoint viewport=VPoint(0, 0));
 
+    /** Request Lomse to render several pages, each one on its own buffer. Pages are
+        independent and are rendered simultaneously using several threads. The result
+        is the same than invoking print_page() for each page.
+        @param pages    The pages to print (0..num_pages - 1).
+        @param buffers  The buffer in which each page will be rendered. All buffers
+            must have the same size and the pixel format of the print buffer.
+        @param width    Buffers width, in pixels.
+        @param height   Buffers height, in pixels.
+        @param viewport The desired viewport, as in print_page().
+        @param numThreads   Maximum number of threads to use. When zero, the number of
+            cores in the computer.
+
+        Before invoking this method, the scale must be set by invoking
+        set_print_page_size(). When threads are not enabled in the build, the pages
+        are rendered sequentially.
+
+        See @subpage page-printing
+    */
+    virtual void print_pages(const std::vector<int>& pages,
+                             const std::vector<unsigned char*>& buffers,
+                             unsigned width, unsigned height,
+                             VPoint viewport=VPoint(0, 0), int numThreads=0);
+
 
     /** Returns the number of pages in current document.
 
@@ -11,6 +11,7 @@
 #define __LOMSE_LMD_ANALYSER_H__
 
 #include <list>
+#include <unordered_map>
 #include "lomse_xml_parser.h"
 #include "lomse_analyser.h"
 #include "lomse_ldp_elements.h"
@@ -183,7 +184,10 @@ protected:
     ImoNote* m_pLastNote;
 
     //tags for xml elements
-    std::map<std::string, int>	m_NameToTag;
+    std::unordered_map<std::string, int>	m_NameToTag;
+
+    //memory for the element analysers
+    ElementAnalysersMemory m_analysers;
 
 public:
     LmdAnalyser(ostream& reporter, LibraryScope& libraryScope, Document* pDoc,
@@ -308,6 +312,7 @@ public:
 
 protected:
     LmdElementAnalyser* new_analyser(const string& name, ImoObj* pAnchor=nullptr);
+    void delete_analyser(LmdElementAnalyser* a);
     void delete_relation_builders();
 
     //auxiliary. for ldp notes analysis
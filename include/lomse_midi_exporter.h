@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#ifndef __LOMSE_MIDI_EXPORTER_H__        //to avoid nested includes
+#define __LOMSE_MIDI_EXPORTER_H__
+
+#include "lomse_basic.h"
+#include "lomse_injectors.h"
+#include "lomse_internal_model.h"
+
+#include <string>
+#include <vector>
+
+
+///@cond INTERNALS
+namespace lomse
+{
+///@endcond
+
+//forward declarations
+class ImoScore;
+class SoundEventsTable;
+class MidiFileEvent;
+
+//---------------------------------------------------------------------------------------
+/** %MidiExporter renders the playback of an score as a Standard MIDI File (type 1).
+
+    The exporter walks the sound events table in the same way as the ScorePlayer does,
+    resolving repetitions, voltas and other jumps, but without waiting for real time,
+    so that the whole score is rendered at full CPU speed. The file contains a
+    conductor track, with the tempo and the time signatures, a track for each MIDI
+    channel used by the score instruments and, optionally, a track with the
+    metronome clicks. Example:
+
+    @code
+        MidiExporter exporter(m_libraryScope);
+        exporter.set_tempo(90);
+        exporter.set_metronome(true);
+        AScore score = ...
+        if (!exporter.save_midi_file(score, path + "score.mid"))
+            std::cout << "file error write" << endl;
+    @endcode
+
+    The exporter does not change the score and it does not use the ScorePlayer, so
+    several exporters can be used simultaneously, in different threads, for
+    exporting different scores.
+*/
+class MidiExporter
+{
+protected:
+    LibraryScope& m_libraryScope;
+    int m_tempo = 60;               //quarter notes per minute
+    bool m_fMetronome = false;      //true= add a track with metronome clicks
+    int m_MtrChannel = 9;           //channel for metronome clicks
+    int m_MtrInstr = 0;             //instrument for metronome clicks
+    int m_MtrTone1 = 60;            //pitch for first beat of measure
+    int m_MtrTone2 = 77;            //pitch for other beats
+
+public:
+    /** Constructor */
+    MidiExporter(LibraryScope& libScope);
+    /** Destructor */
+    virtual ~MidiExporter();
+
+    /** @name Main methods for exporting the score    */
+    //@{
+
+    /** This method renders the playback of the score passed as argument and returns
+        the content of the Standard MIDI File. The returned string contains binary
+        data.
+        @param score  The score to render.
+    */
+    std::string get_midi(AScore score);
+
+    /** This method renders the playback of the score passed as argument and saves
+        it as a Standard MIDI File. Returns @FALSE if the file could not be written.
+        @param score     The score to render.
+        @param filename  The full path for the file to create.
+    */
+    bool save_midi_file(AScore score, const std::string& filename);
+
+    //@}    //main methods
+
+
+    /** @name Options for rendering the score    */
+    //@{
+
+    /** This method sets the tempo to use, in quarter notes per minute. Default value
+        is 60.
+        @param qpm  The number of quarter notes per minute.
+    */
+    inline void set_tempo(int qpm) { m_tempo = (qpm > 0 ? qpm : 60); }
+
+    /** This method controls the generation of a track with metronome clicks. By
+        default, metronome clicks are not generated.
+        @param value  @TRUE for generating the metronome track.
+    */
+    inline void set_metronome(bool value) { m_fMetronome = value; }
+
+    /** This method sets the sounds for the metronome clicks. By default, the
+        exporter uses the same settings than the ScorePlayer: channel 9,
+        instrument 0, pitch 60 for the first beat of each measure and pitch 77 for
+        the other beats.
+        @param channel  The MIDI channel for the metronome track.
+        @param instr    The MIDI instrument for the metronome sounds.
+        @param tone1    The MIDI pitch for the first beat of each measure.
+        @param tone2    The MIDI pitch for the other beats.
+    */
+    void set_metronome_sounds(int channel, int instr, int tone1, int tone2);
+
+    //@}    //settings
+
+
+    /** @name Getters for current options    */
+    //@{
+
+    /** Returns current tempo, in quarter notes per minute.   */
+    inline int get_tempo() const { return m_tempo; }
+
+    /** Returns @TRUE if the metronome track will be generated.   */
+    inline bool get_metronome() const { return m_fMetronome; }
+
+    //@}    //getters for settings
+
+
+//excluded from public API. Only for internal use.
+///@cond INTERNALS
+public:
+    std::string get_midi(ImoScore* pScore);
+    bool save_midi_file(ImoScore* pScore, const std::string& filename);
+
+    //ticks per quarter note in the generated file
+    static const int k_division = 64;     //same as k_duration_quarter: ticks are TU
+
+protected:
+    void render_events(ImoScore* pScore, SoundEventsTable& table,
+                       std::vector< std::vector<MidiFileEvent> >& tracks,
+                       std::vector<std::string>& names);
+    std::string write_file(std::vector< std::vector<MidiFileEvent> >& tracks,
+                           std::vector<std::string>& names);
+    void write_track(std::string& data, std::vector<MidiFileEvent>& events,
+                     const std::string& name);
+
+///@endcond
+};
+
+
+}   //namespace lomse
+
+#endif      //__LOMSE_MIDI_EXPORTER_H__
@@ -186,7 +186,7 @@ class SoundEventsTable
 protected:
     ImoScore* m_pScore;
     int m_numMeasures;
-    std::vector<SoundEvent*> m_events;
+    std::vector<SoundEvent> m_events;
     std::vector<int> m_measures;
     std::vector<int> m_channels;
     std::vector<int> m_semitones;       //transposition for each staff
@@ -204,7 +204,7 @@ public:
     void create_table();
 
     inline int num_events() { return int(m_events.size()); }
-    std::vector<SoundEvent*>& get_events() { return m_events; }
+    std::vector<SoundEvent>& get_events() { return m_events; }
     std::vector<int>& get_channels() { return m_channels; }
     inline int get_first_event_for_measure(int nMeasure) { return m_measures[nMeasure]; }
     inline int get_last_event() { return int(m_events.size()) - 1; }
@@ -242,7 +242,6 @@ protected:
     void add_noterest_events(StaffObjsCursor& cursor, int measure);
     void add_rythm_change(int measure, ImoTimeSignature* pTS);
     void add_jump(StaffObjsCursor& cursor, int measure, JumpEntry* pJump);
-    void delete_events_table();
     void delete_jumps_table();
     void delete_measures_jumps_table();
     int compute_volume(TimeUnits timePos, ImoTimeSignature* pTS, TimeUnits timeShift);
@@ -11,6 +11,7 @@
 #define __LOMSE_MNX_ANALYSER_H__
 
 #include <list>
+#include <unordered_map>
 #include "lomse_xml_parser.h"
 #include "lomse_analyser.h"
 //#include "lomse_ldp_elements.h"
@@ -234,7 +235,10 @@ protected:
 //    int m_nShowTupletNumber;
 
     //conversion from xml element name to int
-    std::map<std::string, int>	m_NameToEnum;
+    std::unordered_map<std::string, int>	m_NameToEnum;
+
+    //memory for the element analysers
+    ElementAnalysersMemory m_analysers;
 
 
 public:
@@ -432,6 +436,7 @@ public:
 protected:
     friend class MnxElementAnalyser;
     MnxElementAnalyser* new_analyser(const std::string& name, ImoObj* pAnchor=nullptr);
+    void delete_analyser(MnxElementAnalyser* a);
     void set_result(AnalysisData* pData);
     void delete_result();
 
@@ -46,7 +46,7 @@ public:
     ModelBuilder() {}
     virtual ~ModelBuilder() {}
 
-    ImoDocument* build_model(ImoDocument* pImoDoc);
+    ImoDocument* build_model(ImoDocument* pImoDoc, bool fAllScores=false);
     void structurize(ImoObj* pImo);
 
     ImoDocument* fix_cloned_model(ImoDocument* pImoDoc);
@@ -11,6 +11,7 @@
 #define __LOMSE_MXL_ANALYSER_H__
 
 #include <list>
+#include <unordered_map>
 #include "lomse_xml_parser.h"
 #include "lomse_analyser.h"
 #include "lomse_ldp_elements.h"
@@ -371,7 +372,10 @@ protected:
 //    int m_nShowTupletNumber;
 
     //conversion from xml element name to int
-    std::map<std::string, int> m_NameToEnum;
+    std::unordered_map<std::string, int> m_NameToEnum;
+
+    //memory for the element analysers
+    ElementAnalysersMemory m_analysers;
 
 public:
     MxlAnalyser(ostream& reporter, LibraryScope& libraryScope, Document* pDoc,
@@ -589,6 +593,7 @@ public:
 
 protected:
     MxlElementAnalyser* new_analyser(const std::string& name, ImoObj* pAnchor=nullptr);
+    void delete_analyser(MxlElementAnalyser* a);
     void delete_relation_builders();
     void add_marging_space_for_lyrics(ImoNote* pNote, ImoLyric* pLyric);
     void add_pending_staffobjs(int voice);
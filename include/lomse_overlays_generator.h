@@ -57,6 +57,7 @@ public:
     void update_visual_effect(VisualEffect* pEffect, BitmapDrawer* pDrawer);
     void set_rendering_buffer(unsigned char* buf, unsigned width, unsigned height);
     void on_new_background();
+    bool restore_background();
     void add_visual_effect(VisualEffect* pEffect);
     void remove_visual_effect(VisualEffect* pEffect);
 
@@ -95,6 +95,8 @@ public:
     virtual void initialize(RenderingBuffer& buf, Color bgcolor) = 0;
     virtual void render() = 0;
     virtual void render(FontRasterizer& ras, FontScanline& sl, Color color) = 0;
+    virtual void render_rectangle(double left, double top, double right, double bottom,
+                                  Color color) = 0;
 //    virtual void render_gsv_text(double x, double y, const char* str) = 0;
     virtual void copy_from(RenderingBuffer& img, const AggRectInt* srcRect,
                            int xDest, int yDest) = 0;
@@ -106,6 +108,11 @@ public:
                                EResamplingQuality resamplingMode,
                                double alpha) = 0;
 
+    //restrict renderization to a region of the rendering buffer (pixels, inclusive)
+    virtual void set_clip_box(int x1, int y1, int x2, int y2) = 0;
+    virtual void reset_clip_box() = 0;
+    virtual void clear_clip_box(Color bgcolor) = 0;
+
     // Make all polygons CCW-oriented
     inline void arrange_orientations() {
         m_path.arrange_orientations_all_paths(path_flags_ccw);
@@ -243,7 +250,12 @@ public:
         //do renderization. Method doing renderization is a template member, so that
         //it can be created for different Renderer types.
         double alpha = 1.0;
-        render(ras, sl, m_renSolid, m_mtx, m_renBase.clip_box(), alpha);
+        //the rasterizer clips geometry at clip box coordinates. Expand it to
+        //include last pixels row and column
+        AggRectInt clipBox = m_renBase.clip_box();
+        ++clipBox.x2;
+        ++clipBox.y2;
+        render(ras, sl, m_renSolid, m_mtx, clipBox, alpha);
 
         ////////render controls
         //////ras.gamma(agg::gamma_none());
@@ -262,6 +274,74 @@ public:
         agg::render_scanlines(ras, sl, m_renSolid);
     }
 
+    //-----------------------------------------------------------------------------------
+    // Fast path for axis-aligned filled rectangles (staff lines, stems, barlines, etc.).
+    // Instead of using the rasterizer, pixels are directly blended: full coverage for
+    // the inner pixels and fractional coverage for the pixels in the edges. The result
+    // is the same as rendering the rectangle as a path.
+    void render_rectangle(double left, double top, double right, double bottom,
+                          Color color) override
+    {
+        //set affine transformation (scale, translation)
+        set_transformation();
+        double x1 = left;
+        double y1 = top;
+        double x2 = right;
+        double y2 = bottom;
+        m_mtx.transform(&x1, &y1);
+        m_mtx.transform(&x2, &y2);
+        if (x1 > x2)
+            std::swap(x1, x2);
+        if (y1 > y2)
+            std::swap(y1, y2);
+
+        //restrict to clip box
+        const AggRectInt& box = m_renBase.clip_box();
+        x1 = std::max(x1, double(box.x1));
+        y1 = std::max(y1, double(box.y1));
+        x2 = std::min(x2, double(box.x2 + 1));
+        y2 = std::min(y2, double(box.y2 + 1));
+        if (x2 <= x1 || y2 <= y1)
+            return;
+
+        typename PixFormat::color_type c( to_rgba(color) );
+        agg::gamma_power gamma(m_gamma);
+        int ix1 = int(floor(x1));
+        int ix2 = int(ceil(x2)) - 1;
+        int iy1 = int(floor(y1));
+        int iy2 = int(ceil(y2)) - 1;
+        double leftCover = (ix1 == ix2 ? x2 - x1 : ix1 + 1.0 - x1);
+        double rightCover = x2 - ix2;
+        for (int iy = iy1; iy <= iy2; ++iy)
+        {
+            double rowCover = std::min(y2, iy + 1.0) - std::max(y1, double(iy));
+            m_renBase.blend_pixel(ix1, iy, c, to_cover(gamma, leftCover * rowCover));
+            if (ix2 > ix1)
+            {
+                agg::cover_type cover = to_cover(gamma, rowCover);
+                if (ix2 > ix1 + 1)
+                    m_renBase.blend_hline(ix1 + 1, iy, ix2 - 1, c, cover);
+                m_renBase.blend_pixel(ix2, iy, c, to_cover(gamma, rightCover * rowCover));
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------------
+    void set_clip_box(int x1, int y1, int x2, int y2) override
+    {
+        m_renBase.clip_box(x1, y1, x2, y2);
+    }
+
+    //-----------------------------------------------------------------------------------
+    void reset_clip_box() override { m_renBase.reset_clipping(true); }
+
+    //-----------------------------------------------------------------------------------
+    void clear_clip_box(Color bgcolor) override
+    {
+        const AggRectInt& box = m_renBase.clip_box();
+        m_renBase.copy_bar(box.x1, box.y1, box.x2, box.y2, to_rgba(bgcolor));
+    }
+
     //-----------------------------------------------------------------------------------
     // Expand all polygons
     void expand(double value) override { m_curved_trans_contour.width(value); }
@@ -313,6 +393,12 @@ public:
 
 protected:
 
+    //-----------------------------------------------------------------------------------
+    static inline agg::cover_type to_cover(const agg::gamma_power& gamma, double area)
+    {
+        return agg::cover_type( agg::uround(gamma(area) * agg::cover_full) );
+    }
+
     //-----------------------------------------------------------------------------------
     // Rendering. You can specify two additional parameters:
     // trans_affine and opacity. They can be used to transform the whole
@@ -17,6 +17,7 @@
 
 
 #include <vector>
+#include <chrono>
 #include <thread>
 #include <condition_variable>
 
@@ -48,6 +49,26 @@ typedef std::thread SoundThread;
 typedef std::condition_variable SoundFlag;
 
 
+//---------------------------------------------------------------------------------------
+/** %MidiMessage describes a sound request for the MidiServerBase. All requests that
+    must take place at the same time are sent together, in a single invocation of
+    MidiServerBase::send_messages().
+*/
+struct MidiMessage
+{
+    enum EType { k_voice_change=0, k_note_on, k_note_off, };
+
+    EType   type;       ///< Type of request
+    int     channel;    ///< MIDI channel
+    int     data1;      ///< Pitch for notes or program number for voice changes
+    int     data2;      ///< Volume for notes. Not used for voice changes
+
+    MidiMessage(EType t, int ch, int d1, int d2=0)
+        : type(t), channel(ch), data1(d1), data2(d2)
+    {
+    }
+};
+
 //---------------------------------------------------------------------------------------
 /** Class %MidiServerBase is a base class defining the interface for any class
     that would like to process the requests from ScorePlayer to generate
@@ -116,6 +137,48 @@ public:
         methods.
     */
     virtual void all_sounds_off() {}
+
+    /** %Request to process several sound requests that must take place at the same
+        time. The default implementation invokes voice_change(), note_on() or
+        note_off() for each message. Override it if your MIDI server can send all
+        of them at once.
+    */
+    virtual void send_messages(const std::vector<MidiMessage>& messages)
+    {
+        for (const MidiMessage& msg : messages)
+        {
+            switch (msg.type)
+            {
+                case MidiMessage::k_voice_change:
+                    voice_change(msg.channel, msg.data1);
+                    break;
+                case MidiMessage::k_note_on:
+                    note_on(msg.channel, msg.data1, msg.data2);
+                    break;
+                case MidiMessage::k_note_off:
+                    note_off(msg.channel, msg.data1, msg.data2);
+                    break;
+            }
+        }
+    }
+};
+
+//---------------------------------------------------------------------------------------
+/** %PlaybackJitter contains timing statistics for the last playback: the delay of the
+    playback thread in waking up at the time for sending sound requests to the
+    MidiServerBase. Delays do not accumulate, as each request is scheduled at its
+    absolute time.
+*/
+struct PlaybackJitter
+{
+    long        numTicks = 0L;      ///< Number of waits for the time of next events
+    long        maxDelay = 0L;      ///< Maximum delay, in microseconds
+    long long   totalDelay = 0L;    ///< Sum of all delays, in microseconds
+
+    ///Mean delay, in microseconds
+    inline long mean_delay() const {
+        return (numTicks > 0 ? long(totalDelay / numTicks) : 0L);
+    }
 };
 
 
@@ -163,6 +226,7 @@ protected:
     bool                m_fFinalEventSent;      //to avoid duplicating final event
     ImoScore*           m_pScore;       //score to play
     SoundEventsTable*   m_pTable;
+    PlaybackJitter      m_jitter;       //timing statistics for last playback
     SoundFlag           m_canPlay;      //playback is not paused
 
     //metronome: MIDI parameters
@@ -317,6 +381,11 @@ public:
     */
     inline bool is_playing() { return m_fPlaying; }
 
+    /** Returns the timing statistics for the last playback. Values are updated
+        while playing, so they are only reliable when playback has finished.
+    */
+    inline PlaybackJitter get_jitter_statistics() { return m_jitter; }
+
 
 ///@cond INTERNALS
 //excluded from public API. Only for internal use.
@@ -335,6 +404,9 @@ protected:
     void thread_main(int nEvStart, int nEvEnd, bool fVisualTracking, long nMM,
                      Interactor* pInteractor);
     void end_of_playback_housekeeping(bool fVisualTracking, Interactor* pInteractor);
+    std::chrono::steady_clock::time_point
+        wait_until(std::chrono::steady_clock::time_point curClock, long waitTime);
+    void send_midi_messages(std::vector<MidiMessage>& batch);
     void set_new_beat_information(SoundEvent* pEvent);
 
     //helper, for do_play()
@@ -138,6 +138,8 @@ public:
 
 protected:
     void draw_leger_lines(Drawer* pDrawer);
+    void draw_leger_line(Drawer* pDrawer, LUnits xPos, LUnits yPos, LUnits lineLength,
+                         bool fRectangle);
 
     //for chords
     friend class GmoShapeChordBaseNote;
@@ -56,6 +56,12 @@ protected:
     std::vector<ColumnDataGourlay*> m_columns;   //columns
     std::vector<ShapeData*> m_shapes;            //data associated to each staff object
 
+    //accumulated columns data, for computing line penalties. Element i contains the
+    //sum for columns 0..i-1
+    std::vector<double> m_slopeSums;
+    std::vector<double> m_fixedSums;
+    std::vector<double> m_minWidthSums;
+
     //auxiliary temporal variables used while collecting columns' data
     TimeSlice*          m_pCurSlice;
     ColStaffObjsEntry*  m_pLastEntry;
@@ -138,6 +144,9 @@ protected:
     void fix_neighborhood_spacing_problems(int iColumnToTrace);
     void compute_springs();
     void determine_spacing_parameters();
+    void compute_columns_accumulated_data();
+    LUnits determine_line_width(int iSystem);
+    LUnits determine_minimum_width_for_line(int iFirstCol, int iLastCol);
     bool accept_for_prolog_slice(ColStaffObjsEntry* pEntry);
     int determine_required_slice_type(ImoStaffObj* pSO, bool fInProlog);
     ShapeData* save_info_for_shape(GmoShape* pShape, int iInstr, int iStaff);
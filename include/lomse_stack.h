@@ -127,6 +127,11 @@ public:
         return (it != m_list.end() ? *it : nullptr);
     }
 
+    //iteration, from bottom to top of the stack
+    typedef typename std::list<T>::iterator iterator;
+    iterator begin() { return m_list.begin(); }
+    iterator end() { return m_list.end(); }
+
 protected:
     void remove_history() {
         typename std::list<T>::iterator it;
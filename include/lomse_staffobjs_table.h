@@ -17,6 +17,7 @@
 #include <vector>
 #include <ostream>
 #include <map>
+#include <unordered_map>
 
 namespace lomse
 {
@@ -113,6 +114,17 @@ protected:
     ColStaffObjsEntry* m_pFirst;
     ColStaffObjsEntry* m_pLast;
 
+    //indexes for fast access
+    std::unordered_map<ImoStaffObj*, ColStaffObjsEntry*> m_entryForStaffObj;
+    std::unordered_map<ImoId, ColStaffObjsEntry*> m_entryForId;
+    std::map<TimeUnits, ColStaffObjsEntry*> m_lastEntryAtTime;  //last entry for each timepos
+
+    //skip pointers: first entry for each measure and for each instrument/measure.
+    //Built on demand and invalidated when the table changes
+    bool m_fMeasuresIndexValid;
+    std::vector<ColStaffObjsEntry*> m_firstInMeasure;
+    std::vector< std::vector<ColStaffObjsEntry*> > m_firstInInstrMeasure;
+
 public:
     ColStaffObjs();
     ~ColStaffObjs();
@@ -135,6 +147,14 @@ public:
                                  ImoStaffObj* pImo);
     void delete_entry_for(ImoStaffObj* pSO);
 
+    //direct access to entries
+    ColStaffObjsEntry* find_entry_for(ImoStaffObj* pSO);
+    ColStaffObjsEntry* find_entry_for_id(ImoId id);
+    ColStaffObjsEntry* first_entry_at_time(TimeUnits time);
+    ColStaffObjsEntry* first_entry_in_measure(int measure);
+    ColStaffObjsEntry* first_entry_in_measure(int instr, int measure);
+    int num_measures();
+
     //iterator related
     class iterator
     {
@@ -203,6 +223,7 @@ public:
     inline ColStaffObjsEntry* back() { return m_pLast; }
     inline ColStaffObjsEntry* front() { return m_pFirst; }
     inline iterator find(ImoStaffObj* pSO) { return iterator(find_entry_for(pSO)); }
+    inline iterator find(ImoId id) { return iterator(find_entry_for_id(id)); }
 
     //debug
     std::string dump(bool fWithIds=true);
@@ -224,7 +245,10 @@ protected:
     inline void set_divisions(int div) { m_divisions = div; }
 
     void add_entry_to_list(ColStaffObjsEntry* pEntry);
-    ColStaffObjsEntry* find_entry_for(ImoStaffObj* pSO);
+    ColStaffObjsEntry* find_insertion_hint(ColStaffObjsEntry* pEntry);
+    void add_to_time_index(ColStaffObjsEntry* pEntry);
+    void remove_from_time_index(ColStaffObjsEntry* pEntry);
+    void build_measures_index();
 
 };
 
@@ -35,6 +35,9 @@
 #include "lomse_document.h"
 
 #include <sstream>
+#if (LOMSE_ENABLE_THREADS == 1)
+    #include <mutex>
+#endif
 
 ///@cond INTERNALS
 namespace lomse
@@ -96,8 +99,12 @@ protected:
     IdAssigner*     m_pIdAssigner = nullptr;    //basically a map id <--> ptr to ImoObj
     ImoDocument*    m_pImoDoc = nullptr;        //the internal model tree
     RelObjCloner*   m_pRelObjCloner = nullptr;  //helper to clone ImoRelObj nodes
+    ImArena*        m_pArena = nullptr;         //memory for the internal model objects
     unsigned int    m_flags = k_dirty;
     long            m_imRef = -1L;               //this model unique id number
+#if (LOMSE_ENABLE_THREADS == 1)
+    std::mutex      m_mutex;                    //see DocModelLock
+#endif
 
 
     DocModel(Document* pDoc);
@@ -114,6 +121,7 @@ public:
     ///Values for flags
     enum EDocumentFlags {
         k_dirty             = 0x0001,   ///< dirty: modified since last "clear_dirty()" ==> need to rebuild GModel
+        k_untracked_changes = 0x0002,   ///< modified without marking the modified objects as dirty ==> need to structurize all scores
     };
 
     //access to key objects
@@ -121,6 +129,7 @@ public:
     inline Document* get_owner_document() { return m_pDoc; }
     inline IdAssigner* get_id_assigner() { return m_pIdAssigner; }
     RelObjCloner* get_relobj_cloner();
+    inline ImArena* get_arena() { return m_pArena; }
 
     //information
     inline std::string get_language() { return (m_pImoDoc ? m_pImoDoc->get_language() : "en"); }
@@ -144,6 +153,9 @@ public:
     inline bool is_dirty() { return (m_flags & k_dirty) != 0; }
     inline void set_dirty() { m_flags |= k_dirty; }
     inline void clear_dirty() { m_flags &= ~k_dirty; }
+    inline bool has_untracked_changes() { return (m_flags & k_untracked_changes) != 0; }
+    inline void set_untracked_changes() { m_flags |= k_untracked_changes; }
+    inline void clear_untracked_changes() { m_flags &= ~k_untracked_changes; }
 
     //unique model reference
     void add_unique_model_ref();
@@ -154,10 +166,36 @@ public:
 protected:
     DocModel& clone(const DocModel& a);
 
+    friend class DocModelLock;
 
 };
 
 
+//---------------------------------------------------------------------------------------
+/** %DocModelLock serializes, while it exists, the changes to data shared by all the
+    objects in a DocModel (ids, memory arena and dirty marks). It is required when
+    creating or deleting internal model objects while several scores are being
+    structurized in parallel. Without threads support it does nothing.
+*/
+class DocModelLock
+{
+protected:
+#if (LOMSE_ENABLE_THREADS == 1)
+    std::lock_guard<std::mutex> m_lock;
+#endif
+
+public:
+#if (LOMSE_ENABLE_THREADS == 1)
+    explicit DocModelLock(DocModel* pDocModel) : m_lock(pDocModel->m_mutex) {}
+#else
+    explicit DocModelLock(DocModel* UNUSED(pDocModel)) {}
+#endif
+
+    DocModelLock(const DocModelLock&) = delete;
+    DocModelLock& operator= (const DocModelLock&) = delete;
+};
+
+
 //------------------------------------------------------------------------------------
 /** The %Document class is a facade object that contains, basically, the @IM, a model
     similar to the DOM in HTML. By accessing and modifying this internal model you
@@ -347,7 +385,7 @@ public:
             m_pModel->m_pImoDoc->set_page_content_scale(scale);
     }
 
-    void end_of_changes();
+    void end_of_changes(bool fAllScores=false);
 
     /** Return the ImoPageInfo node for this %Document. ImoPageInfo contains the
         document intended paper size. Example:
@@ -660,6 +698,7 @@ public:
     inline bool is_modified() { return m_modified > 0; }
     inline void set_modified() { ++m_modified; }
     inline void reset_modified() { if (m_modified > 0) --m_modified; }
+    inline bool has_untracked_changes() { return m_pModel->has_untracked_changes(); }
 
     //debug
     std::string dump_ids() const;
@@ -676,12 +715,16 @@ protected:
     Compiler* get_compiler_for_format(int format);
     void fix_malformed_musicxml();
 
-    //dirty flag: need to rebuild GModel
+    //dirty flag: need to rebuild GModel. When the modified objects are not marked as
+    //dirty, all scores must be structurized in end_of_changes()
     friend class CheckboxCtrl;
     friend class ImoObj;
     friend class Interactor;
     friend class DocCommandExecuter;
-    inline void set_dirty() { if(m_pModel) m_pModel->set_dirty(); }
+    inline void set_dirty() {
+        if(m_pModel) { m_pModel->set_dirty(); m_pModel->set_untracked_changes(); }
+    }
+    inline void set_dirty_by_object() { if(m_pModel) m_pModel->set_dirty(); }
     inline void clear_dirty() { if(m_pModel) m_pModel->clear_dirty(); }
 
     //There is a design bug: ImoControl constructor needs to access ImoDocument for
@@ -36,6 +36,7 @@
 #include "lomse_image.h"
 #include "lomse_logger.h"
 #include "lomse_engraving_options.h"
+#include "lomse_im_arena.h"
 typedef int TIntAttribute;
 
 #include <string>
@@ -1150,6 +1151,8 @@ protected:
     AttrObj(int idx) : m_attrbIdx(idx) {}
 
 public:
+    LOMSE_IM_ARENA_ALLOCATION
+
     //the five special
     virtual ~AttrObj() { delete m_next; }
     AttrObj(const AttrObj& a) = default;    //{ clone(a); }
@@ -1490,6 +1493,8 @@ protected:
     virtual void initialize_object() {}
 
 public:
+    LOMSE_IM_ARENA_ALLOCATION
+
     //the five special
     ~ImoObj() override;
     ImoObj(const ImoObj& a) : Visitable(), TreeNode<ImoObj>(a) { clone(a); }
@@ -1727,6 +1732,7 @@ public:
         //set attribute value
     template<typename T> void set_attribute(TIntAttribute idx, const T& value)
     {
+        ImArenaScope arena( get_model_arena() );
         AttrObj* pAttr = get_attribute(idx);
         if (pAttr)
         {
@@ -1790,6 +1796,7 @@ protected:
 
     friend class FixModelVisitor;
     inline void anchor_to_model(DocModel* pDocModel) { m_pDocModel = pDocModel; }
+    ImArena* get_model_arena();
 
 
     AttrObj* add_attribute(AttrObj* newAttr) { m_attribs.push_back(newAttr); return newAttr; }
@@ -5986,6 +5993,7 @@ protected:
     int m_accidentalsModel = k_only_notation_provided;  //how pitch//accidentals are initialized
     ColStaffObjs* m_pColStaffObjs = nullptr;
     SoundEventsTable* m_pMidiTable = nullptr;
+    bool m_fStructurized = false;   //associated structures are updated
     float m_scaling;                        //global scaling tenths -> LUnits
     ImoSystemInfo m_systemInfoFirst;
     ImoSystemInfo m_systemInfoOther;
@@ -6028,6 +6036,11 @@ public:
     inline void set_accidentals_model(int value) { m_accidentalsModel = value; }
     inline void set_source_format(int format) { m_sourceFormat = format; }
 
+    //associated structures (ColStaffObjs, measures tables, etc.) are up to date. This
+    //mark is removed when the score or any of its children is marked as dirty.
+    inline bool is_structurized() const { return m_fStructurized; }
+    inline void set_structurized(bool value) { m_fStructurized = value; }
+
     enum { k_empty=0, k_ldp, k_musicxml, k_mnx, };
 
     //getters and info
@@ -6112,7 +6125,7 @@ public:
     /** When you modify the content of an score it is necessary to update associated
         structures, such as the staffobjs collection. For this it is mandatory to
         invoke this method. Alternatively, you can invoke Document::end_of_changes(),
-        that will invoke this method on all scores. */
+        that will invoke this method on all modified scores. */
     void end_of_changes();
 
 
@@ -70,6 +70,9 @@
 // Accept without warning/error LDP v1.5 syntax
 #define LOMSE_COMPATIBILITY_LDP_1_5     @LOMSE_COMPATIBILITY_LDP_1_5@
 
+// Allocate internal model objects in a memory arena per document
+#define LOMSE_ENABLE_IM_ARENA     @LOMSE_ENABLE_IM_ARENA@
+
 // Enable debug logs. It is independent of build mode: debug or release
 #define LOMSE_ENABLE_DEBUG_LOGS     @LOMSE_ENABLE_DEBUG_LOGS@
 
@@ -82,6 +85,9 @@
 // Enable threads (requires pthreads). If not enabled, ScorePlayer will not be included
 #define LOMSE_ENABLE_THREADS    @LOMSE_ENABLE_THREADS@
 
+// Deliver events directly to observers instead of using the events thread
+#define LOMSE_DIRECT_INVOCATION     @LOMSE_DIRECT_INVOCATION@
+
 
 #endif  // __LOMSE_CONFIG_H__
 
@@ -28,6 +28,7 @@
 #include "lomse_score_utilities.h"
 
 #include <sstream>
+#include <chrono>
 using namespace std;
 
 namespace lomse
@@ -231,6 +232,65 @@ DocCommandExecuter::DocCommandExecuter(Document* target)
 DocCommandExecuter::~DocCommandExecuter()
 {
     delete m_pModelStart;
+    delete_all_checkpoints();
+}
+
+//---------------------------------------------------------------------------------------
+void DocCommandExecuter::set_checkpoints_policy(int numCommands, long milliseconds,
+                                                int maxCheckpoints)
+{
+    m_checkpointCommands = max(0, numCommands);
+    m_checkpointMillisecs = max(0L, milliseconds);
+    m_maxCheckpoints = max(0, maxCheckpoints);
+
+    while (int(m_checkpoints.size()) > m_maxCheckpoints)
+    {
+        delete m_checkpoints.front().second;
+        m_checkpoints.pop_front();
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void DocCommandExecuter::save_checkpoint_if_needed(double millisecs)
+{
+    ++m_cmdsSinceCheckpoint;
+    m_replayTime += millisecs;
+
+    if (m_maxCheckpoints == 0)
+        return;
+
+    if ((m_checkpointCommands > 0 && m_cmdsSinceCheckpoint >= m_checkpointCommands)
+        || (m_checkpointMillisecs > 0 && m_replayTime >= double(m_checkpointMillisecs)))
+    {
+        if (int(m_checkpoints.size()) >= m_maxCheckpoints)
+        {
+            delete m_checkpoints.front().second;
+            m_checkpoints.pop_front();
+        }
+        m_checkpoints.push_back( make_pair(m_stack.size(), m_pDoc->create_model_copy()) );
+        m_cmdsSinceCheckpoint = 0;
+        m_replayTime = 0.0;
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void DocCommandExecuter::delete_checkpoints_after(size_t numCmds)
+{
+    //checkpoints for states after executing more than numCmds commands are no
+    //longer valid
+    while (!m_checkpoints.empty() && m_checkpoints.back().first > numCmds)
+    {
+        delete m_checkpoints.back().second;
+        m_checkpoints.pop_back();
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void DocCommandExecuter::delete_all_checkpoints()
+{
+    for (auto& checkpoint : m_checkpoints)
+        delete checkpoint.second;
+    m_checkpoints.clear();
 }
 
 //---------------------------------------------------------------------------------------
@@ -256,7 +316,9 @@ int DocCommandExecuter::execute(DocCursor* pCursor, DocCommand* pCmd,
         if (pCmd->get_cursor_update_policy() == DocCommand::k_refresh)
             pCmd->set_final_cursor_pos( pCursor->get_pointee_id() );
 
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
         result = pCmd->perform_action(m_pDoc, pCursor);
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
         m_error = pCmd->get_error();
         if ( result == k_success && pCmd->is_reversible())
         {
@@ -266,6 +328,7 @@ int DocCommandExecuter::execute(DocCursor* pCursor, DocCommand* pCmd,
             update_cursor(pCursor, pCmd);
             update_selection(pSelection, pCmd);
             m_pDoc->set_modified();
+            save_checkpoint_if_needed(elapsed.count());
         }
         else if (pCmd->is_reversible())
             delete pUE;     //cmd ownership transferred to UE; this deletes cmd
@@ -375,6 +438,7 @@ void DocCommandExecuter::undo(DocCursor* pCursor, SelectionSet* pSelection)
     if (pUE)
     {
         DocCommand* cmd = pUE->pCmd;
+        delete_checkpoints_after(m_stack.size());
         if (cmd->get_undo_policy() == DocCommand::k_undo_policy_replay_from_start)
             replay_until(pUE, pCursor, pSelection);
         else
@@ -383,6 +447,8 @@ void DocCommandExecuter::undo(DocCursor* pCursor, SelectionSet* pSelection)
             pCursor->restore_state( pUE->cursorState );
             pSelection->restore_state( pUE->selState );
         }
+        m_cmdsSinceCheckpoint = 0;
+        m_replayTime = 0.0;
         m_pDoc->set_dirty();
     }
 }
@@ -391,20 +457,26 @@ void DocCommandExecuter::undo(DocCursor* pCursor, SelectionSet* pSelection)
 void DocCommandExecuter::replay_until(UndoElement* pUE, DocCursor* pCursor,
                                       SelectionSet* pSelection)
 {
-    //restore initial model
-    m_pDoc->replace_model(m_pModelStart);
-    m_pModelStart = LOMSE_NEW DocModel(*m_pModelStart);
-
-    //re-play all commands until the desired one
-    for (size_t i=0; i < m_stack.size(); ++i)
+    //restore the nearest checkpoint or, if none, the initial model
+    size_t iStart = 0;
+    if (m_checkpoints.empty())
     {
-        UndoElement* pUEi = m_stack.get_item(i);
-        if (pUEi == pUE)
-            break;
-
-        replay_command(pUEi, pCursor, pSelection);
+        m_pDoc->replace_model(m_pModelStart);
+        m_pModelStart = LOMSE_NEW DocModel(*m_pModelStart);
+    }
+    else
+    {
+        iStart = m_checkpoints.back().first;
+        m_pDoc->replace_model( LOMSE_NEW DocModel(*(m_checkpoints.back().second)) );
     }
 
+    //re-play all commands after the restored state until the desired one
+    UndoableStack<UndoElement*>::iterator it = m_stack.begin();
+    for (size_t i=0; i < iStart && it != m_stack.end(); ++i)
+        ++it;
+    for (; it != m_stack.end() && *it != pUE; ++it)
+        replay_command(*it, pCursor, pSelection);
+
     //restore selection and cursor state
     pCursor->restore_state( pUE->cursorState );
     pSelection->restore_state( pUE->selState );
@@ -433,7 +505,9 @@ void DocCommandExecuter::redo(DocCursor* pCursor, SelectionSet* pSelection)
         pCursor->restore_state( pUE->cursorState );
         pSelection->restore_state( pUE->selState );
         DocCommand* cmd = pUE->pCmd;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
         cmd->perform_action(m_pDoc, pCursor);
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
 
         update_cursor(pCursor, cmd);
         update_selection(pSelection, cmd);
@@ -441,7 +515,10 @@ void DocCommandExecuter::redo(DocCursor* pCursor, SelectionSet* pSelection)
 
         //by design, all commands that modify the document are reversible
         if (cmd->is_reversible())
+        {
             m_pDoc->set_modified();
+            save_checkpoint_if_needed(elapsed.count());
+        }
     }
 }
 
@@ -34,6 +34,7 @@
 #include "lomse_autoclef.h"
 #include "lomse_relobj_cloner.h"
 
+#include <atomic>
 #include <sstream>
 using namespace std;
 
@@ -161,6 +162,7 @@ DocModel::DocModel(Document* pDoc)
     , m_pIdAssigner( LOMSE_NEW IdAssigner() )
     , m_pImoDoc(nullptr)
     , m_pRelObjCloner(nullptr)
+    , m_pArena( LOMSE_NEW ImArena() )
     , m_flags(k_dirty)
     , m_imRef(-1L)
 {
@@ -172,6 +174,7 @@ DocModel::~DocModel()
     delete m_pImoDoc;
     delete m_pIdAssigner;
     delete m_pRelObjCloner;
+    m_pArena->release();
 }
 
 //---------------------------------------------------------------------------------------
@@ -180,6 +183,9 @@ DocModel& DocModel::clone(const DocModel& a)
     //instantiate member variables
     m_pDoc = a.m_pDoc;
     m_pIdAssigner = LOMSE_NEW IdAssigner();
+    if (!m_pArena)
+        m_pArena = LOMSE_NEW ImArena();
+    ImArenaScope arena(m_pArena);
     m_pImoDoc = static_cast<ImoDocument*>( ImFactory::clone(a.m_pImoDoc) );
     m_flags = a.m_flags;
 
@@ -211,7 +217,7 @@ DocModel& DocModel::clone(const DocModel& a)
 //---------------------------------------------------------------------------------------
 void DocModel::add_unique_model_ref()
 {
-    static long m_refsCounter = 0L;     //global counter to create unique id numbers
+    static std::atomic<long> m_refsCounter(0L);     //global counter to create unique id numbers
 
     m_imRef = ++m_refsCounter;
 }
@@ -443,10 +449,11 @@ void Document::create_with_empty_score()
 }
 
 //---------------------------------------------------------------------------------------
-void Document::end_of_changes()
+void Document::end_of_changes(bool fAllScores)
 {
     ModelBuilder builder;
-    builder.build_model(m_pModel->m_pImoDoc);
+    builder.build_model(m_pModel->m_pImoDoc, fAllScores);
+    m_pModel->clear_untracked_changes();
     m_pModel->add_unique_model_ref();
 }
 
@@ -1401,7 +1408,9 @@ AScore ADocument::first_score() const
 */
 void ADocument::end_of_changes()
 {
-    pimpl()->end_of_changes();
+    //API setters do not mark the modified objects as dirty. Therefore, all scores
+    //must be processed
+    pimpl()->end_of_changes(true);
 }
 
 
@@ -12,6 +12,7 @@
 #include "lomse_ldp_elements.h"
 #include "lomse_internal_model.h"
 #include "lomse_im_note.h"
+#include "lomse_im_measures_table.h"
 #include "lomse_time.h"
 #include "lomse_logger.h"
 
@@ -1170,9 +1171,8 @@ void ScoreCursor::to_time(int iInstr, int iStaff, TimeUnits rTargetTime)
     m_currentState.instrument(iInstr);
     m_currentState.staff(iStaff);
 
-    //optimization: avoid search from start if current time lower than target time
-    if (!p_there_is_iter_object() || is_greater_time(p_iter_object_time(), rTargetTime))
-        m_it = m_pColStaffObjs->begin();
+    //optimization: use the time index to skip all entries with lower time
+    m_it = ColStaffObjsIterator( m_pColStaffObjs->first_entry_at_time(rTargetTime) );
 
     p_forward_to_instr_with_time_not_lower_than(rTargetTime);
 
@@ -1228,7 +1228,12 @@ void ScoreCursor::to_measure(int measure, int instr, int staff)
     m_startOfBarTimepos = 0.0;
     m_curBeatDuration = k_duration_quarter;
 
-    m_it = m_pColStaffObjs->begin();
+    //optimization: start at the first entry of the measure ending with the
+    //searched barline. When found, time signature info is updated later, when
+    //moving to next staffobj
+    ColStaffObjsEntry* pStart =
+        m_pColStaffObjs->first_entry_in_measure(m_currentState.instrument(), measure - 1);
+    m_it = (pStart ? ColStaffObjsIterator(pStart) : m_pColStaffObjs->begin());
     while (p_there_is_iter_object())
     {
         if (p_iter_object_instrument() == m_currentState.instrument())
@@ -1432,10 +1437,7 @@ void ScoreCursor::p_move_iterator_to(ImoId id)
     if (id <= k_no_imoid)
         m_it = m_pColStaffObjs->end();
     else
-    {
-        m_it = m_pColStaffObjs->begin();
-        for (; m_it != m_pColStaffObjs->end() && (*m_it)->element_id() != id; ++m_it);
-    }
+        m_it = ColStaffObjsIterator( m_pColStaffObjs->find_entry_for_id(id) );
 }
 
 //---------------------------------------------------------------------------------------
@@ -1832,6 +1834,11 @@ void ScoreCursor::p_find_start_of_measure_and_time_signature()
             {
                 m_startOfBarTimepos = p_iter_object_time();
                 fBarlineFound = true;
+
+                //optimization: time signature in previous measures is in the
+                //measures table. Avoid scanning back to the start of the score
+                if (!fTimeFound)
+                    fTimeFound = p_beat_duration_from_measures_table();
             }
             if (!fTimeFound && p_iter_object()->is_time_signature())
             {
@@ -1848,5 +1855,24 @@ void ScoreCursor::p_find_start_of_measure_and_time_signature()
     m_it = itSave;
 }
 
+//---------------------------------------------------------------------------------------
+bool ScoreCursor::p_beat_duration_from_measures_table()
+{
+    //Iterator is pointing to the barline ending a measure. Sets the beat duration
+    //for the time signature in effect at the end of this measure. Returns false if
+    //the measures table is not available
+
+    ImoInstrument* pInstr = m_pScore->get_instrument( m_currentState.instrument() );
+    ImMeasuresTable* pTable = (pInstr ? pInstr->get_measures_table() : nullptr);
+    int measure = p_iter_object_measure();
+    if (!pTable || measure < 0 || measure >= pTable->num_entries())
+        return false;
+
+    TimeUnits beat = pTable->get_measure(measure)->get_implied_beat_duration();
+    if (beat != LOMSE_NO_DURATION)
+        m_curBeatDuration = beat;
+    return true;
+}
+
 
 }  //namespace lomse
@@ -0,0 +1,395 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include "lomse_midi_exporter.h"
+
+#include "lomse_internal_model.h"
+#include "lomse_midi_table.h"
+#include "lomse_logger.h"
+
+#include <fstream>
+#include <algorithm>
+using namespace std;
+
+namespace lomse
+{
+
+//=======================================================================================
+// Helper class MidiFileEvent: an event for a track of the MIDI file
+//=======================================================================================
+class MidiFileEvent
+{
+public:
+    long time;                  //absolute time, in ticks
+    int size;                   //num. of bytes in data
+    unsigned char data[7];      //status byte and data bytes
+
+    MidiFileEvent(long t, unsigned char status, int data1, int data2)
+        : time(t), size(3)
+    {
+        data[0] = status;
+        data[1] = (unsigned char)(data1 & 0x7F);
+        data[2] = (unsigned char)(data2 & 0x7F);
+    }
+
+    MidiFileEvent(long t, unsigned char status, int data1)
+        : time(t), size(2)
+    {
+        data[0] = status;
+        data[1] = (unsigned char)(data1 & 0x7F);
+    }
+
+    //meta event with up to four bytes of data
+    MidiFileEvent(long t, unsigned char type, const unsigned char* bytes, int numBytes)
+        : time(t), size(3 + numBytes)
+    {
+        data[0] = 0xFF;
+        data[1] = type;
+        data[2] = (unsigned char)numBytes;
+        for (int i=0; i < numBytes; ++i)
+            data[3+i] = bytes[i];
+    }
+};
+
+
+//=======================================================================================
+// Helper functions for encoding the MIDI file
+//=======================================================================================
+static void write_int(string& data, unsigned long value, int numBytes)
+{
+    for (int i=numBytes-1; i >= 0; --i)
+        data += char((value >> (8 * i)) & 0xFF);
+}
+
+//---------------------------------------------------------------------------------------
+static void write_var_length(string& data, unsigned long value)
+{
+    unsigned char buffer[5];
+    int n = 0;
+    buffer[n++] = (unsigned char)(value & 0x7F);
+    while ((value >>= 7) > 0)
+        buffer[n++] = (unsigned char)((value & 0x7F) | 0x80);
+
+    while (n > 0)
+        data += char(buffer[--n]);
+}
+
+//---------------------------------------------------------------------------------------
+static bool is_earlier_event(const MidiFileEvent& a, const MidiFileEvent& b)
+{
+    return a.time < b.time;
+}
+
+
+//=======================================================================================
+// MidiExporter implementation
+//=======================================================================================
+MidiExporter::MidiExporter(LibraryScope& libScope)
+    : m_libraryScope(libScope)
+{
+}
+
+//---------------------------------------------------------------------------------------
+MidiExporter::~MidiExporter()
+{
+}
+
+//---------------------------------------------------------------------------------------
+void MidiExporter::set_metronome_sounds(int channel, int instr, int tone1, int tone2)
+{
+    m_MtrChannel = channel;
+    m_MtrInstr = instr;
+    m_MtrTone1 = tone1;
+    m_MtrTone2 = tone2;
+}
+
+//---------------------------------------------------------------------------------------
+string MidiExporter::get_midi(AScore score)
+{
+    if (score.is_valid())
+        return get_midi(score.internal_object());
+
+    return string();
+}
+
+//---------------------------------------------------------------------------------------
+bool MidiExporter::save_midi_file(AScore score, const std::string& filename)
+{
+    if (score.is_valid())
+        return save_midi_file(score.internal_object(), filename);
+
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+string MidiExporter::get_midi(ImoScore* pScore)
+{
+    //A private table is used, instead of the one cached in the score, because
+    //following the jumps changes the jump entries counters.
+    SoundEventsTable table(pScore);
+    table.create_table();
+
+    vector< vector<MidiFileEvent> > tracks;
+    vector<string> names;
+    render_events(pScore, table, tracks, names);
+    return write_file(tracks, names);
+}
+
+//---------------------------------------------------------------------------------------
+bool MidiExporter::save_midi_file(ImoScore* pScore, const std::string& filename)
+{
+    ofstream file(filename, ios::out | ios::binary);
+    if (!file.good())
+    {
+        LOMSE_LOG_ERROR("Error opening file %s", filename.c_str());
+        return false;
+    }
+
+    string data = get_midi(pScore);
+    file.write(data.c_str(), data.size());
+    file.close();
+    return file.good();
+}
+
+//---------------------------------------------------------------------------------------
+void MidiExporter::render_events(ImoScore* pScore, SoundEventsTable& table,
+                                 vector< vector<MidiFileEvent> >& tracks,
+                                 vector<string>& names)
+{
+    //This method follows the logic of ScorePlayer::do_play(), but times are not
+    //converted to real time: the time for each event is the sum of the time in the
+    //score and the time shift introduced by the jumps already executed.
+
+    //conductor track
+    tracks.resize(1);
+    names.push_back("");
+    unsigned long tempo = 60000000UL / (unsigned long)m_tempo;     //microsecs per quarter
+    unsigned char bytes[4];
+    bytes[0] = (unsigned char)((tempo >> 16) & 0xFF);
+    bytes[1] = (unsigned char)((tempo >> 8) & 0xFF);
+    bytes[2] = (unsigned char)(tempo & 0xFF);
+    tracks[0].emplace_back(0L, 0x51, bytes, 3);
+
+    //a track for each channel used by the instruments
+    int channelTrack[16];
+    for (int i=0; i < 16; ++i)
+        channelTrack[i] = -1;
+
+    vector<int>& channels = table.get_channels();
+    for (int i=0; i < int(channels.size()); ++i)
+    {
+        int channel = channels[i] & 0x0F;
+        if (channelTrack[channel] == -1)
+        {
+            channelTrack[channel] = int(tracks.size());
+            tracks.resize(tracks.size() + 1);
+            names.push_back( pScore->get_instrument(i)->get_name().text );
+        }
+    }
+
+    //metronome track. It is added after the channel tracks
+    vector<MidiFileEvent> mtr;
+    unsigned char mtrChannel = (unsigned char)(m_MtrChannel & 0x0F);
+    if (m_fMetronome)
+        mtr.emplace_back(0L, 0xC0 | mtrChannel, m_MtrInstr);
+
+    //metronome beat information. Default 4/4 until a time signature is found
+    long measureDuration = long(k_duration_whole);
+    long pulseDuration = long(k_duration_quarter);
+    long gridStart = - long(table.get_anacrusis_missing_time() + 0.5);
+    long nextClick = 0;
+
+    std::vector<SoundEvent>& events = table.get_events();
+    int numEvents = int(events.size());
+    long timeShift = 0;         //time added by the jumps already executed
+    long endTime = 0;
+
+    //limit for jumps, to protect against endless loops in malformed scores
+    int maxJumps = 100 * (table.num_jumps() + 1);
+    int numJumps = 0;
+
+    int i = 0;
+    while (i < numEvents)
+    {
+        SoundEvent& ev = events[i];
+        long t = ev.DeltaTime;
+
+        //metronome clicks before this event
+        if (m_fMetronome)
+        {
+            long clickDuration = min(7L, pulseDuration / 4L);
+            for (; nextClick < t; nextClick += pulseDuration)
+            {
+                bool fFirstBeat = ((nextClick - gridStart) % measureDuration == 0);
+                int tone = (fFirstBeat ? m_MtrTone1 : m_MtrTone2);
+                int volume = (fFirstBeat ? 127 : 80);
+                long time = nextClick + timeShift;
+                mtr.emplace_back(time, 0x90 | mtrChannel, tone, volume);
+                mtr.emplace_back(time + clickDuration, 0x80 | mtrChannel, tone, 64);
+            }
+        }
+
+        unsigned char channel = (unsigned char)(ev.Channel & 0x0F);
+        int trackIdx = channelTrack[channel];
+        if (trackIdx == -1 && (ev.EventType == SoundEvent::k_prog_instr
+                               || ev.EventType == SoundEvent::k_note_on))
+        {
+            //channel not used by the instruments but set by a sound change
+            trackIdx = channelTrack[channel] = int(tracks.size());
+            tracks.resize(tracks.size() + 1);
+            names.push_back("");
+        }
+        long time = t + timeShift;
+
+        switch (ev.EventType)
+        {
+            case SoundEvent::k_prog_instr:
+                if (trackIdx > 0)
+                    tracks[trackIdx].emplace_back(time, 0xC0 | channel, ev.Instrument);
+                break;
+
+            case SoundEvent::k_note_on:
+                if (trackIdx > 0)
+                {
+                    int volume = max(1, min(127, ev.Volume));
+                    tracks[trackIdx].emplace_back(time, 0x90 | channel, ev.NotePitch,
+                                                  volume);
+                }
+                break;
+
+            case SoundEvent::k_note_off:
+                if (trackIdx > 0)
+                    tracks[trackIdx].emplace_back(time, 0x80 | channel, ev.NotePitch, 64);
+                break;
+
+            case SoundEvent::k_rhythm_change:
+            {
+                measureDuration = long(ev.TopNumber) * long(ev.BeatDuration);
+                pulseDuration = max(1L, measureDuration / long(max(1, ev.NumPulses)));
+                if (t > 0)
+                    gridStart = t;
+                long elapsed = t - gridStart;
+                nextClick = gridStart
+                            + ((elapsed + pulseDuration - 1) / pulseDuration) * pulseDuration;
+
+                //time signature meta event. Denominator as power of two
+                int denominator = int(k_duration_whole) / max(1, ev.BeatDuration);
+                int power = 0;
+                while ((1 << power) < denominator)
+                    ++power;
+                bytes[0] = (unsigned char)ev.TopNumber;
+                bytes[1] = (unsigned char)power;
+                bytes[2] = (unsigned char)(24L * pulseDuration / long(k_duration_quarter));
+                bytes[3] = 8;
+                tracks[0].emplace_back(time, 0x58, bytes, 4);
+                break;
+            }
+
+            case SoundEvent::k_jump:
+            {
+                JumpEntry* pJump = ev.pJump;
+                if (pJump->get_visited() >= pJump->get_times_before()
+                    && (pJump->get_times_valid() == 0
+                        || pJump->get_times_valid() > pJump->get_executed())
+                    && ++numJumps <= maxJumps)
+                {
+                    if (pJump->get_times_valid() > pJump->get_executed())
+                        pJump->increment_applied();
+                    pJump->increment_visited();
+
+                    i = pJump->get_event();
+                    long target = events[i].DeltaTime;
+                    timeShift += t - target;
+
+                    //realign metronome clicks
+                    long elapsed = target - gridStart;
+                    nextClick = gridStart
+                        + ((elapsed + pulseDuration - 1) / pulseDuration) * pulseDuration;
+                    continue;
+                }
+                pJump->increment_visited();
+                break;
+            }
+
+            case SoundEvent::k_end_of_score:
+                endTime = time;
+                break;
+
+            default:
+                break;
+        }
+        endTime = max(endTime, time);
+        ++i;
+    }
+
+    if (m_fMetronome)
+    {
+        tracks.push_back(mtr);
+        names.push_back("Metronome");
+    }
+
+    //end of all tracks at the end of the score
+    for (auto& track : tracks)
+    {
+        stable_sort(track.begin(), track.end(), is_earlier_event);
+        long time = (track.empty() ? endTime : max(endTime, track.back().time));
+        track.emplace_back(time, 0x2F, bytes, 0);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+string MidiExporter::write_file(vector< vector<MidiFileEvent> >& tracks,
+                                vector<string>& names)
+{
+    string data;
+
+    //header chunk
+    data += "MThd";
+    write_int(data, 6, 4);
+    write_int(data, 1, 2);                  //format 1
+    write_int(data, tracks.size(), 2);      //number of tracks
+    write_int(data, k_division, 2);         //ticks per quarter note
+
+    for (size_t i=0; i < tracks.size(); ++i)
+        write_track(data, tracks[i], names[i]);
+
+    return data;
+}
+
+//---------------------------------------------------------------------------------------
+void MidiExporter::write_track(string& data, vector<MidiFileEvent>& events,
+                               const string& name)
+{
+    string track;
+
+    //track name
+    if (!name.empty())
+    {
+        write_var_length(track, 0);
+        track += char(0xFF);
+        track += char(0x03);
+        write_var_length(track, name.size());
+        track += name;
+    }
+
+    long prevTime = 0;
+    for (auto& ev : events)
+    {
+        write_var_length(track, (unsigned long)(ev.time - prevTime));
+        prevTime = ev.time;
+        track.append(reinterpret_cast<const char*>(ev.data), ev.size);
+    }
+
+    data += "MTrk";
+    write_int(data, track.size(), 4);
+    data += track;
+}
+
+
+}   //namespace lomse
@@ -500,6 +500,26 @@ void SpAlgGourlay::do_spacing(int iColumnToTrace)
             dbgLogger << endl;
         }
     }
+
+    compute_columns_accumulated_data();
+}
+
+//---------------------------------------------------------------------------------------
+void SpAlgGourlay::compute_columns_accumulated_data()
+{
+    //Line breaking requires, for many lines, the sum of columns' data. Accumulated
+    //values are computed here so that these sums are just a subtraction
+
+    size_t numCols = m_columns.size();
+    m_slopeSums.assign(numCols + 1, 0.0);
+    m_fixedSums.assign(numCols + 1, 0.0);
+    m_minWidthSums.assign(numCols + 1, 0.0);
+    for (size_t i = 0; i < numCols; ++i)
+    {
+        m_slopeSums[i+1] = m_slopeSums[i] + double(m_columns[i]->m_slope);
+        m_fixedSums[i+1] = m_fixedSums[i] + double(m_columns[i]->m_xFixed);
+        m_minWidthSums[i+1] = m_minWidthSums[i] + double(m_columns[i]->get_minimum_width());
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -897,23 +917,15 @@ float SpAlgGourlay::determine_penalty_for_line(int iSystem, int iFirstCol, int i
 //        return -1.0f;
 //    }
 
-    LUnits lineWidth = m_pScoreLyt->get_target_size_for_system(iSystem);
-    if (iSystem > 0)
-        lineWidth -= 1000.0f; //m_pScoreLyt->get_prolog_width_for_system(iSystem);
+    LUnits lineWidth = determine_line_width(iSystem);
 
     //determine composite spacing function sff[cicj]
     //                       j                          j
     //    sff[cicj] = 1 / ( SUM ( 1/Cappn ) )  = 1 / ( SUM ( slope.n ) )
     //                      n=i                        n=i
-    float sum = 0.0f;
-    LUnits fixed = 0.0f;
-    LUnits minWidth = 0.0f;
-    for (int i = iFirstCol; i <= iLastCol; ++i)
-    {
-        sum += m_columns[i]->m_slope;
-        fixed += m_columns[i]->m_xFixed;
-        minWidth += m_columns[i]->get_minimum_width();
-    }
+    float sum = float(m_slopeSums[iLastCol+1] - m_slopeSums[iFirstCol]);
+    LUnits fixed = LUnits(m_fixedSums[iLastCol+1] - m_fixedSums[iFirstCol]);
+    LUnits minWidth = determine_minimum_width_for_line(iFirstCol, iLastCol);
     float c = 1.0f / sum;
 
     //if minimum width is greater than required width, it is impossible to achieve
@@ -972,6 +984,21 @@ float SpAlgGourlay::determine_penalty_for_line(int iSystem, int iFirstCol, int i
     return R;
 }
 
+//---------------------------------------------------------------------------------------
+LUnits SpAlgGourlay::determine_line_width(int iSystem)
+{
+    LUnits lineWidth = m_pScoreLyt->get_target_size_for_system(iSystem);
+    if (iSystem > 0)
+        lineWidth -= 1000.0f; //m_pScoreLyt->get_prolog_width_for_system(iSystem);
+    return lineWidth;
+}
+
+//---------------------------------------------------------------------------------------
+LUnits SpAlgGourlay::determine_minimum_width_for_line(int iFirstCol, int iLastCol)
+{
+    return LUnits(m_minWidthSums[iLastCol+1] - m_minWidthSums[iFirstCol]);
+}
+
 //---------------------------------------------------------------------------------------
 bool SpAlgGourlay::is_better_option(float prevPenalty, float newPenalty,
                                     float nextPenalty, int UNUSED(i), int UNUSED(j))
@@ -10,6 +10,7 @@
 #include "lomse_glyphs.h"
 
 #include "lomse_injectors.h"
+#include "lomse_calligrapher.h"
 
 
 namespace lomse
@@ -878,6 +879,7 @@ const GlyphData m_glyphs_smufl[] =
 MusicGlyphs::MusicGlyphs(LibraryScope* pLibScope)
     : m_pLibScope(pLibScope)
     , m_glyphs(nullptr)
+    , m_fontPathsRevision(0L)
 {
     update();
 }
@@ -887,6 +889,46 @@ void MusicGlyphs::update()
 {
     if (m_pLibScope->is_music_font_smufl_compliant())
         m_glyphs = &m_glyphs_smufl[0];
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_metrics.clear();
+    m_fontPathsRevision = m_pLibScope->get_font_paths_revision();
+}
+
+//---------------------------------------------------------------------------------------
+GlyphMetrics MusicGlyphs::get_glyph_metrics(unsigned int glyphCode, double fontHeight)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //saved metrics are not valid if the music font could have changed, i.e. the
+    //default fonts path is used for the music font
+    long revision = m_pLibScope->get_font_paths_revision();
+    if (m_fontPathsRevision != revision)
+    {
+        m_metrics.clear();
+        m_fontPathsRevision = revision;
+    }
+
+    std::pair<double, unsigned int> key(fontHeight, glyphCode);
+    std::map<std::pair<double, unsigned int>, GlyphMetrics>::iterator it =
+        m_metrics.find(key);
+    if (it != m_metrics.end())
+        return it->second;
+
+    //not yet measured. Measuring requires to rasterize the glyph
+    GlyphMetrics metrics;
+    TextMeter meter(*m_pLibScope);
+    if (meter.select_font("any",
+                          m_pLibScope->get_music_font_file(),
+                          m_pLibScope->get_music_font_name(),
+                          fontHeight))
+    {
+        return metrics;     //font not available. Do not save the metrics
+    }
+    metrics.bbox = meter.bounding_rectangle(glyphCode);
+    metrics.advance = meter.get_advance_x(glyphCode);
+    m_metrics[key] = metrics;
+    return metrics;
 }
 
 }  //namespace lomse
@@ -13,6 +13,7 @@
 #include "lomse_internal_model.h"
 #include "lomse_im_note.h"
 #include "lomse_drawer.h"
+#include "lomse_display_list.h"
 #include "lomse_selections.h"
 #include "lomse_time.h"
 #include "lomse_control.h"
@@ -22,6 +23,9 @@
 
 #include <cstdlib>      //abs
 #include <iomanip>
+#include <algorithm>    //sort, unique
+#include <cmath>        //sqrt
+#include <functional>   //greater
 using namespace std;
 
 
@@ -49,11 +53,45 @@ GmoObj::GmoObj(int objtype, ImoObj* pCreatorImo)
 {
 }
 
+//---------------------------------------------------------------------------------------
+//the drawing bounds cached in boxes must be recomputed when an object is moved or
+//modified, and the page display list must be recorded again
+static void invalidate_drawing_bounds_for(GmoObj* pGmo)
+{
+    GmoBox* pBox = (pGmo->is_box() ? static_cast<GmoBox*>(pGmo)
+                                   : pGmo->get_owner_box());
+    if (!pBox)
+        return;
+
+    pBox->invalidate_drawing_bounds();
+
+    //invalidating bounds stops at the first box with invalid bounds. But the page
+    //display list must always be discarded
+    while (pBox && !pBox->is_box_doc_page())
+        pBox = pBox->get_owner_box();
+    if (pBox)
+        static_cast<GmoBoxDocPage*>(pBox)->invalidate_display_list();
+}
+
 //---------------------------------------------------------------------------------------
 GmoObj::~GmoObj()
 {
 }
 
+//---------------------------------------------------------------------------------------
+void GmoObj::set_width(LUnits width)
+{
+    m_size.width = width;
+    invalidate_drawing_bounds_for(this);
+}
+
+//---------------------------------------------------------------------------------------
+void GmoObj::set_height(LUnits height)
+{
+    m_size.height = height;
+    invalidate_drawing_bounds_for(this);
+}
+
 //---------------------------------------------------------------------------------------
 void GmoObj::set_origin(UPoint& pos)
 {
@@ -71,6 +109,7 @@ void GmoObj::set_origin(LUnits xLeft, LUnits yTop)
 {
     m_origin.x = xLeft;
     m_origin.y = yTop;
+    invalidate_drawing_bounds_for(this);
 }
 
 //---------------------------------------------------------------------------------------
@@ -102,6 +141,7 @@ void GmoObj::shift_origin(const USize& shift)
 {
     m_origin.x += shift.width;
     m_origin.y += shift.height;
+    invalidate_drawing_bounds_for(this);
 }
 
 //---------------------------------------------------------------------------------------
@@ -211,6 +251,7 @@ void GmoObj::set_dirty(bool dirty)
     if (dirty)
     {
         m_flags |= k_dirty;
+        invalidate_drawing_bounds_for(this);
         propagate_dirty();
     }
     else
@@ -232,6 +273,9 @@ void GmoObj::propagate_dirty()
         m_pParentBox->propagate_dirty();
     }
 
+    if (this->is_box_doc_page())
+        static_cast<GmoBoxDocPage*>(this)->invalidate_display_list();
+
     if (this->is_box_document())
     {
         GmoBoxDocument* pBox = static_cast<GmoBoxDocument*>(this);
@@ -314,6 +358,7 @@ GmoBox::GmoBox(int objtype, ImoObj* pCreatorImo)
     , m_uBottomMargin(0.0f)
     , m_uLeftMargin(0.0f)
     , m_uRightMargin(0.0f)
+    , m_fDrawBoundsValid(false)
 {
 }
 
@@ -347,6 +392,7 @@ void GmoBox::add_child_box(GmoBox* child)
 {
     m_childBoxes.push_back(child);
     child->set_owner_box(this);
+    invalidate_drawing_bounds_for(this);
 }
 
 //---------------------------------------------------------------------------------------
@@ -364,6 +410,7 @@ void GmoBox::add_shape(GmoShape* shape, int layer)
     shape->set_layer(layer);
     shape->set_owner_box(this);
     m_shapes.push_back(shape);
+    invalidate_drawing_bounds_for(this);
 }
 
 //---------------------------------------------------------------------------------------
@@ -436,13 +483,18 @@ void GmoBox::set_flag_value(bool value, unsigned int flag)
 //---------------------------------------------------------------------------------------
 void GmoBox::on_draw(Drawer* pDrawer, RenderOptions& opt)
 {
+    pDrawer->start_object( get_drawing_bounds() );
     draw_border(pDrawer, opt);
     draw_shapes(pDrawer, opt);
 
-    //draw contained boxes
+    //draw contained boxes. Skip those out of the visible area. Drawing bounds are
+    //only computed when culling is enabled
     std::vector<GmoBox*>::iterator it;
     for (it=m_childBoxes.begin(); it != m_childBoxes.end(); ++it)
-        (*it)->on_draw(pDrawer, opt);
+    {
+        if (!opt.use_clip_rect || opt.is_visible( (*it)->get_drawing_bounds() ))
+            (*it)->on_draw(pDrawer, opt);
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -450,7 +502,64 @@ void GmoBox::draw_shapes(Drawer* pDrawer, RenderOptions& opt)
 {
     std::list<GmoShape*>::iterator itS;
     for (itS=m_shapes.begin(); itS != m_shapes.end(); ++itS)
-        (*itS)->on_draw(pDrawer, opt);
+    {
+        if (opt.is_visible( (*itS)->get_bounds() ))
+        {
+            pDrawer->start_object( (*itS)->get_bounds() );
+            (*itS)->on_draw(pDrawer, opt);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------
+URect GmoBox::get_drawing_bounds()
+{
+    //Shapes can exceed the bounds of its owner box (e.g. ties, lyrics). Therefore,
+    //for culling it is necessary to use the bounds of all the box content.
+
+    if (!m_fDrawBoundsValid)
+    {
+        LUnits xLeft = get_left();
+        LUnits yTop = get_top();
+        LUnits xRight = get_right();
+        LUnits yBottom = get_bottom();
+
+        std::list<GmoShape*>::iterator itS;
+        for (itS=m_shapes.begin(); itS != m_shapes.end(); ++itS)
+        {
+            xLeft = min(xLeft, (*itS)->get_left());
+            yTop = min(yTop, (*itS)->get_top());
+            xRight = max(xRight, (*itS)->get_right());
+            yBottom = max(yBottom, (*itS)->get_bottom());
+        }
+
+        std::vector<GmoBox*>::iterator itB;
+        for (itB=m_childBoxes.begin(); itB != m_childBoxes.end(); ++itB)
+        {
+            URect bounds = (*itB)->get_drawing_bounds();
+            xLeft = min(xLeft, bounds.left());
+            yTop = min(yTop, bounds.top());
+            xRight = max(xRight, bounds.right());
+            yBottom = max(yBottom, bounds.bottom());
+        }
+
+        m_drawBounds = URect(xLeft, yTop, xRight - xLeft, yBottom - yTop);
+        m_fDrawBoundsValid = true;
+    }
+    return m_drawBounds;
+}
+
+//---------------------------------------------------------------------------------------
+void GmoBox::invalidate_drawing_bounds()
+{
+    GmoBox* pBox = this;
+    while (pBox && pBox->m_fDrawBoundsValid)
+    {
+        pBox->m_fDrawBoundsValid = false;
+        if (pBox->is_box_doc_page())
+            static_cast<GmoBoxDocPage*>(pBox)->invalidate_shapes_grid();
+        pBox = pBox->get_parent_box();
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -592,6 +701,7 @@ void GmoBox::shift_origin_and_content(const USize& shift)
 
     m_origin.x += shift.width;
     m_origin.y += shift.height;
+    invalidate_drawing_bounds_for(this);
 
     //shift contained boxes
     std::vector<GmoBox*>::iterator itB;
@@ -913,12 +1023,20 @@ public:
 GmoBoxDocPage::GmoBoxDocPage(ImoObj* pCreatorImo)
     : GmoBox(GmoObj::k_box_doc_page, pCreatorImo)
     , m_numPage(1)
+    , m_fGridValid(false)
+    , m_cellWidth(0.0f)
+    , m_cellHeight(0.0f)
+    , m_numCols(0)
+    , m_numRows(0)
+    , m_fDisplayListRecorded(false)
+    , m_displayListMemory(0)
 {
 }
 
 //---------------------------------------------------------------------------------------
 void GmoBoxDocPage::on_draw(Drawer* pDrawer, RenderOptions& opt)
 {
+    pDrawer->start_object( get_bounds() );
     if (pDrawer->accepts_id_class())
     {
         stringstream ss;
@@ -930,6 +1048,51 @@ void GmoBoxDocPage::on_draw(Drawer* pDrawer, RenderOptions& opt)
     GmoBox::on_draw(pDrawer, opt);
 }
 
+//---------------------------------------------------------------------------------------
+void GmoBoxDocPage::draw_using_display_list(Drawer* pDrawer, RenderOptions& opt)
+{
+    std::shared_ptr<DisplayList> pList;
+    {
+        std::lock_guard<std::mutex> lock(m_displayListMutex);
+        if (!m_pDisplayList || !m_pDisplayList->is_valid_for(pDrawer, opt))
+        {
+            //record all the page. Culling is done when replaying
+            m_pDisplayList.reset( LOMSE_NEW DisplayList(pDrawer, opt) );
+            RenderOptions recordOpt = opt;
+            recordOpt.use_clip_rect = false;
+            RecordingDrawer recorder(pDrawer, m_pDisplayList.get());
+            on_draw(&recorder, recordOpt);
+            m_fDisplayListRecorded = true;
+            m_displayListMemory = m_pDisplayList->memory_used();
+        }
+        pList = m_pDisplayList;
+    }
+    pList->replay(pDrawer, opt);
+}
+
+//---------------------------------------------------------------------------------------
+void GmoBoxDocPage::invalidate_display_list()
+{
+    //this is invoked each time an object in the page is moved. Avoid locking when
+    //there is nothing to discard
+    if (!m_fDisplayListRecorded)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_displayListMutex);
+    m_pDisplayList.reset();
+    m_fDisplayListRecorded = false;
+    m_displayListMemory = 0;
+}
+
+//---------------------------------------------------------------------------------------
+void GmoBoxDocPage::set_display_list(DisplayList* pList)
+{
+    std::lock_guard<std::mutex> lock(m_displayListMutex);
+    m_pDisplayList.reset(pList);
+    m_fDisplayListRecorded = (pList != nullptr);
+    m_displayListMemory = (pList ? pList->memory_used() : 0);
+}
+
 //---------------------------------------------------------------------------------------
 void GmoBoxDocPage::draw_page_background(Drawer* pDrawer, RenderOptions& UNUSED(opt))
 {
@@ -960,6 +1123,16 @@ void GmoBoxDocPage::add_to_tables(GmoShape* pShape)
     else
         m_allShapes.insert(it, pShape);
 
+    //shapes in lower layers are placed before
+    ImoObj* pImo = pShape->get_creator_imo();
+    map<ImoObj*, GmoShape*>::iterator itF = m_firstShapeForImo.find(pImo);
+    if (itF == m_firstShapeForImo.end())
+        m_firstShapeForImo[pImo] = pShape;
+    else if (itF->second->get_layer() > layer)
+        itF->second = pShape;
+
+    m_fGridValid = false;
+    invalidate_display_list();
     store_in_map_imo_shape(pShape);
 }
 
@@ -990,11 +1163,22 @@ GmoShape* GmoBoxDocPage::get_first_shape_for_layer(int layer)
 //---------------------------------------------------------------------------------------
 GmoShape* GmoBoxDocPage::find_shape_at(LUnits x, LUnits y)
 {
-    std::list<GmoShape*>::reverse_iterator it;
-    for (it = m_allShapes.rbegin(); it != m_allShapes.rend(); ++it)
+    if (!m_fGridValid)
+        build_shapes_grid();
+
+    if (x < m_gridBounds.left() || x > m_gridBounds.right()
+        || y < m_gridBounds.top() || y > m_gridBounds.bottom())
     {
-        if ((*it)->hit_test(x, y))
-            return *it;
+        return nullptr;
+    }
+
+    //shapes in upper layers have precedence
+    std::vector<int>& cell = m_gridCells[grid_row(y) * m_numCols + grid_col(x)];
+    std::vector<int>::reverse_iterator it;
+    for (it = cell.rbegin(); it != cell.rend(); ++it)
+    {
+        if (m_gridShapes[*it]->hit_test(x, y))
+            return m_gridShapes[*it];
     }
     return nullptr;
 }
@@ -1002,13 +1186,56 @@ GmoShape* GmoBoxDocPage::find_shape_at(LUnits x, LUnits y)
 //---------------------------------------------------------------------------------------
 GmoShape* GmoBoxDocPage::find_shape_for_object(ImoStaffObj* pSO)
 {
-    std::list<GmoShape*>::iterator it;
-    for (it = m_allShapes.begin(); it != m_allShapes.end(); ++it)
+    map<ImoObj*, GmoShape*>::iterator it = m_firstShapeForImo.find(pSO);
+    if (it != m_firstShapeForImo.end())
+        return it->second;
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------------------
+void GmoBoxDocPage::build_shapes_grid()
+{
+    //The page area covered by shapes is split in cells of equal size. Each cell
+    //keeps the list of shapes overlapping it, so that hit testing and selection only
+    //have to check a few shapes
+
+    m_gridBounds = get_drawing_bounds();
+    m_gridShapes.assign(m_allShapes.begin(), m_allShapes.end());
+
+    int numShapes = int(m_gridShapes.size());
+    m_numCols = min(64, 1 + int(sqrt(double(numShapes))));
+    m_numRows = m_numCols;
+    m_cellWidth = max(1.0f, m_gridBounds.get_width() / float(m_numCols));
+    m_cellHeight = max(1.0f, m_gridBounds.get_height() / float(m_numRows));
+
+    m_gridCells.assign(m_numCols * m_numRows, std::vector<int>());
+    for (int i=0; i < numShapes; ++i)
     {
-        if ((*it)->was_created_by(pSO))
-            return *it;
+        GmoShape* pShape = m_gridShapes[i];
+        int colEnd = grid_col(pShape->get_right());
+        int rowEnd = grid_row(pShape->get_bottom());
+        for (int row = grid_row(pShape->get_top()); row <= rowEnd; ++row)
+        {
+            for (int col = grid_col(pShape->get_left()); col <= colEnd; ++col)
+                m_gridCells[row * m_numCols + col].push_back(i);
+        }
     }
-    return nullptr;
+
+    m_fGridValid = true;
+}
+
+//---------------------------------------------------------------------------------------
+int GmoBoxDocPage::grid_col(LUnits x)
+{
+    int col = int((x - m_gridBounds.left()) / m_cellWidth);
+    return max(0, min(m_numCols - 1, col));
+}
+
+//---------------------------------------------------------------------------------------
+int GmoBoxDocPage::grid_row(LUnits y)
+{
+    int row = int((y - m_gridBounds.top()) / m_cellHeight);
+    return max(0, min(m_numRows - 1, row));
 }
 
 //---------------------------------------------------------------------------------------
@@ -1030,14 +1257,37 @@ void GmoBoxDocPage::select_objects_in_rectangle(SelectionSet* selection,
                                                 const URect& selRect,
                                                 unsigned UNUSED(flags))
 {
+    if (!m_fGridValid)
+        build_shapes_grid();
+
+    //collect candidate shapes from the cells overlapping the selection rectangle
+    std::vector<int> candidates;
+    if (m_gridBounds.intersects(selRect))
+    {
+        int colEnd = grid_col(selRect.right());
+        int rowEnd = grid_row(selRect.bottom());
+        for (int row = grid_row(selRect.top()); row <= rowEnd; ++row)
+        {
+            for (int col = grid_col(selRect.left()); col <= colEnd; ++col)
+            {
+                std::vector<int>& cell = m_gridCells[row * m_numCols + col];
+                candidates.insert(candidates.end(), cell.begin(), cell.end());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), std::greater<int>());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+    }
+
     bool fSomethingSelected = false;
-    std::list<GmoShape*>::reverse_iterator it;
-    for (it = m_allShapes.rbegin(); it != m_allShapes.rend(); ++it)
+    std::vector<int>::iterator it;
+    for (it = candidates.begin(); it != candidates.end(); ++it)
     {
-        URect bbox = (*it)->get_bounds();
+        GmoShape* pShape = m_gridShapes[*it];
+        URect bbox = pShape->get_bounds();
         if (selRect.contains(bbox))
         {
-            selection->add(*it);
+            selection->add(pShape);
             fSomethingSelected = true;
         }
     }
@@ -1122,7 +1372,10 @@ void GmoBoxControl::on_draw(Drawer* pDrawer, RenderOptions& opt)
     GmoBox::on_draw(pDrawer, opt);
 
     if (m_pControl)
+    {
+        pDrawer->start_object( get_drawing_bounds() );
         m_pControl->on_draw(pDrawer, opt);
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 #include "lomse_score_algorithms.h"
 #include "lomse_logger.h"
 
+#include <atomic>
 #include <cstdlib>      //abs
 #include <iomanip>
 
@@ -38,11 +39,16 @@ namespace lomse
 //=======================================================================================
 // Graphic model implementation
 //=======================================================================================
-static long m_idCounter = 0L;
+static std::atomic<long> m_idCounter(0L);
+
+//max. memory for the display lists of all pages. A dense page takes about 1 MB
+static const size_t k_display_lists_budget = 32 * 1024 * 1024;
 
 //---------------------------------------------------------------------------------------
 GraphicModel::GraphicModel(ImoDocument* pCreator)
     : m_modified(true)
+    , m_revision(0L)
+    , m_displayListsBudget(k_display_lists_budget)
 {
     m_root = LOMSE_NEW GmoBoxDocument(this, pCreator);
     m_modelId = ++m_idCounter;
@@ -81,9 +87,10 @@ void GraphicModel::draw_page(int iPage, UPoint& origin, Drawer* pDrawer,
     GmoBoxDocPage* pPage = get_page(iPage);
     if (pPage)
     {
-        pPage->on_draw(pDrawer, opt);
+        pPage->draw_using_display_list(pDrawer, opt);
         pDrawer->render();
         pDrawer->remove_shift();
+        keep_display_lists_within_budget(iPage);
     }
     else
     {
@@ -93,6 +100,35 @@ void GraphicModel::draw_page(int iPage, UPoint& origin, Drawer* pDrawer,
     }
 }
 
+//---------------------------------------------------------------------------------------
+void GraphicModel::keep_display_lists_within_budget(int iPage)
+{
+    std::lock_guard<std::mutex> lock(m_displayListsMutex);
+
+    m_pagesWithDisplayList.remove(iPage);
+    m_pagesWithDisplayList.push_front(iPage);
+
+    //the list for the page just drawn is always kept
+    size_t bytes = 0;
+    list<int>::iterator it = m_pagesWithDisplayList.begin();
+    while (it != m_pagesWithDisplayList.end())
+    {
+        GmoBoxDocPage* pPage = get_page(*it);
+        size_t pageBytes = (pPage ? pPage->get_display_list_memory() : 0);
+        bytes += pageBytes;
+        if (it != m_pagesWithDisplayList.begin()
+            && (pageBytes == 0 || bytes > m_displayListsBudget))
+        {
+            if (pPage)
+                pPage->invalidate_display_list();
+            bytes -= pageBytes;
+            it = m_pagesWithDisplayList.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
 //---------------------------------------------------------------------------------------
 void GraphicModel::dump_page(int iPage, ostream& outStream)
 {
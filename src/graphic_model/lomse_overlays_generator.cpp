@@ -118,6 +118,25 @@ void OverlaysGenerator::on_new_background()
     m_fFullRectangle = true;
 }
 
+//---------------------------------------------------------------------------------------
+bool OverlaysGenerator::restore_background()
+{
+    //Removes overlays from the rendering buffer. Returns false if the clean copy is
+    //not available
+
+    if (m_pSaveBytes == nullptr
+        || m_savedBuffer.width() != m_canvasBuffer.width()
+        || m_savedBuffer.height() != m_canvasBuffer.height())
+    {
+        return false;
+    }
+
+    if (m_fBackgroundDirty)
+        m_canvasBuffer.copy_from(m_savedBuffer);
+    m_fBackgroundDirty = false;
+    return true;
+}
+
 //---------------------------------------------------------------------------------------
 void OverlaysGenerator::save_rendering_buffer()
 {
@@ -325,6 +325,13 @@ void GmoShapeBarline::on_draw(Drawer* pDrawer, RenderOptions& opt)
 void GmoShapeBarline::draw_thin_line(Drawer* pDrawer, LUnits uxPos, LUnits uyTop,
                                      LUnits uyBottom, Color color)
 {
+    if (pDrawer->accepts_filled_rectangles())
+    {
+        pDrawer->filled_rectangle(uxPos, uyTop, uxPos + m_uThinLineWidth, uyBottom,
+                                  color);
+        return;
+    }
+
     pDrawer->begin_path();
     pDrawer->fill(color);
     pDrawer->stroke(color);
@@ -338,6 +345,12 @@ void GmoShapeBarline::draw_thin_line(Drawer* pDrawer, LUnits uxPos, LUnits uyTop
 void GmoShapeBarline::draw_thick_line(Drawer* pDrawer, LUnits uxPos, LUnits uyTop,
                                       LUnits uWidth, LUnits uHeight, Color color)
 {
+    if (pDrawer->accepts_filled_rectangles())
+    {
+        pDrawer->filled_rectangle(uxPos, uyTop, uxPos + uWidth, uyTop + uHeight, color);
+        return;
+    }
+
     pDrawer->begin_path();
     pDrawer->fill(color);
     pDrawer->stroke(color);
@@ -86,6 +86,15 @@ void GmoShapeBeam::on_draw(Drawer* pDrawer, RenderOptions& opt)
 void GmoShapeBeam::draw_beam_segment(Drawer* pDrawer, LUnits uxStart, LUnits uyStart,
                              LUnits uxEnd, LUnits uyEnd, Color color)
 {
+    if (uyStart == uyEnd && pDrawer->accepts_filled_rectangles())
+    {
+        //beam segment without slope
+        LUnits halfThickness = m_uBeamThickness / 2.0f;
+        pDrawer->filled_rectangle(uxStart, uyStart - halfThickness,
+                                  uxEnd, uyEnd + halfThickness, color);
+        return;
+    }
+
     pDrawer->begin_path();
     pDrawer->fill(color);
     pDrawer->line(uxStart, uyStart, uxEnd, uyEnd, m_uBeamThickness, k_edge_vertical);
@@ -111,14 +111,18 @@ void GmoShapeNote::draw_leger_lines(Drawer* pDrawer)
     if (pDrawer->accepts_id_class())
         pDrawer->start_simple_notation("", "ledger-line");
 
-    pDrawer->begin_path();
-    pDrawer->fill(Color(0, 0, 0, 0));
-    pDrawer->stroke(Color(0, 0, 0));
-    pDrawer->stroke_width(m_uLineThickness);
-
     LUnits xPos = get_notehead_left() - m_uLineOutgoing;
     LUnits lineLength = get_notehead_width() + 2.0f * m_uLineOutgoing;
 
+    bool fRectangles = pDrawer->accepts_filled_rectangles();
+    if (!fRectangles)
+    {
+        pDrawer->begin_path();
+        pDrawer->fill(Color(0, 0, 0, 0));
+        pDrawer->stroke(Color(0, 0, 0));
+        pDrawer->stroke_width(m_uLineThickness);
+    }
+
     if (m_nPosOnStaff >= m_nTopPosOnStaff)     //lines at top
 	{
         //AWARE: m_uyStaffTopLine refers to the fifth line of a five lines staff. It has
@@ -128,8 +132,7 @@ void GmoShapeNote::draw_leger_lines(Drawer* pDrawer)
 
         for (int i=m_nTopPosOnStaff; i <= m_nPosOnStaff; i+=2)
         {
-            pDrawer->move_to(xPos, yPos);
-            pDrawer->hline_to(xPos + lineLength);
+            draw_leger_line(pDrawer, xPos, yPos, lineLength, fRectangles);
             yPos -= m_lineSpacing;
         }
     }
@@ -142,13 +145,30 @@ void GmoShapeNote::draw_leger_lines(Drawer* pDrawer)
 
         for (int i=m_nBottomPosOnStaff; i >= m_nPosOnStaff; i-=2)
         {
-            pDrawer->move_to(xPos, yPos);
-            pDrawer->hline_to(xPos + lineLength);
+            draw_leger_line(pDrawer, xPos, yPos, lineLength, fRectangles);
             yPos += m_lineSpacing;
         }
     }
 
-    pDrawer->end_path();
+    if (!fRectangles)
+        pDrawer->end_path();
+}
+
+//---------------------------------------------------------------------------------------
+void GmoShapeNote::draw_leger_line(Drawer* pDrawer, LUnits xPos, LUnits yPos,
+                                   LUnits lineLength, bool fRectangle)
+{
+    if (fRectangle)
+    {
+        LUnits halfThickness = m_uLineThickness / 2.0f;
+        pDrawer->filled_rectangle(xPos, yPos - halfThickness, xPos + lineLength,
+                                  yPos + halfThickness, Color(0, 0, 0));
+    }
+    else
+    {
+        pDrawer->move_to(xPos, yPos);
+        pDrawer->hline_to(xPos + lineLength);
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -12,7 +12,6 @@
 #include "lomse_internal_model.h"
 #include "lomse_drawer.h"
 #include "lomse_glyphs.h"
-#include "lomse_calligrapher.h"
 #include "lomse_gm_basic.h"
 #include "agg_trans_affine.h"
 
@@ -54,12 +53,8 @@ void GmoShapeGlyph::compute_size_origin(double fontHeight, UPoint pos)
 {
     m_fontHeight = fontHeight;
 
-    TextMeter meter(m_libraryScope);
-    meter.select_font("any",
-                      m_libraryScope.get_music_font_file(),
-                      m_libraryScope.get_music_font_name(),
-                      m_fontHeight);
-    URect bbox = meter.bounding_rectangle(m_glyph);
+    MusicGlyphs* pGlyphs = m_libraryScope.get_glyphs_table();
+    URect bbox = pGlyphs->get_glyph_metrics(m_glyph, m_fontHeight).bbox;
 
     m_origin.x = pos.x + bbox.x;
     m_origin.y = pos.y + bbox.y;
@@ -86,6 +81,7 @@ GmoShapeImage::GmoShapeImage(ImoObj* pCreatorImo, SpImage image, UPoint pos, USi
 void GmoShapeImage::set_image(SpImage image)
 {
     m_image = image;
+    set_dirty(true);
 }
 
 //---------------------------------------------------------------------------------------
@@ -184,14 +180,22 @@ void GmoShapeSimpleLine::on_draw(Drawer* pDrawer, RenderOptions& opt)
         pDrawer->start_simple_notation("", get_name());
 
     Color color = determine_color_to_use(opt);
-    pDrawer->begin_path();
-    pDrawer->fill(color);
-    pDrawer->stroke(color);
-    pDrawer->stroke_width(m_uWidth);
-    pDrawer->move_to(m_origin.x + m_uWidth / 2.0f, m_origin.y);
-    pDrawer->line_to(m_origin.x + m_uWidth / 2.0f, m_origin.y + m_size.height);
-    pDrawer->end_path();
-    pDrawer->render();
+    if (pDrawer->accepts_filled_rectangles())
+    {
+        pDrawer->filled_rectangle(m_origin.x, m_origin.y, m_origin.x + m_uWidth,
+                                  m_origin.y + m_size.height, color);
+    }
+    else
+    {
+        pDrawer->begin_path();
+        pDrawer->fill(color);
+        pDrawer->stroke(color);
+        pDrawer->stroke_width(m_uWidth);
+        pDrawer->move_to(m_origin.x + m_uWidth / 2.0f, m_origin.y);
+        pDrawer->line_to(m_origin.x + m_uWidth / 2.0f, m_origin.y + m_size.height);
+        pDrawer->end_path();
+        pDrawer->render();
+    }
 
     GmoSimpleShape::on_draw(pDrawer, opt);
 }
@@ -533,16 +537,14 @@ void GmoShapeArpeggio::increase_length_up(LUnits increment)
 //---------------------------------------------------------------------------------------
 void GmoShapeArpeggio::compute_shape_geometry(LUnits xRight, LUnits yTop, LUnits yBottom)
 {
-    TextMeter meter(m_libraryScope);
-    meter.select_font("any",
-                      m_libraryScope.get_music_font_file(),
-                      m_libraryScope.get_music_font_name(),
-                      m_fontHeight);
+    MusicGlyphs* pGlyphs = m_libraryScope.get_glyphs_table();
+    const GlyphMetrics segmentMetrics =
+        pGlyphs->get_glyph_metrics(m_segmentGlyph, m_fontHeight);
 
-    const URect segmentGlyphBox = meter.bounding_rectangle(m_segmentGlyph);
+    const URect segmentGlyphBox = segmentMetrics.bbox;
     m_xInitialAdvance = 0;
     m_yInitialAdvance = -segmentGlyphBox.x;
-    m_segmentAdvance = meter.get_advance_x(m_segmentGlyph);
+    m_segmentAdvance = segmentMetrics.advance;
 
     LUnits maxGlyphHeight = segmentGlyphBox.height;
 
@@ -550,7 +552,8 @@ void GmoShapeArpeggio::compute_shape_geometry(LUnits xRight, LUnits yTop, LUnits
 
     if (m_arrowGlyph)
     {
-        const URect arrowGlyphBox = meter.bounding_rectangle(m_arrowGlyph);
+        const URect arrowGlyphBox =
+            pGlyphs->get_glyph_metrics(m_arrowGlyph, m_fontHeight).bbox;
         remainingHeight -= arrowGlyphBox.right();
 
         if (arrowGlyphBox.height > maxGlyphHeight)
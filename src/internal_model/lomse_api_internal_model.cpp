@@ -1406,6 +1406,7 @@ void AInstrGroup::set_barlines_mode(EJoinBarlines value)
 {
     ensure_validity();
     pimpl()->set_join_barlines(value);
+    pimpl()->set_dirty(true);
 }
 
 //---------------------------------------------------------------------------------------
@@ -1528,6 +1529,7 @@ bool AInstrGroup::set_range(int iFirstInstr, int iLastInstr)
         && (iLastInstr > iFirstInstr && iLastInstr < maxInstr) )
     {
         pimpl()->set_range(iFirstInstr, iLastInstr);
+        pimpl()->set_dirty(true);
         return true;
     }
     else
@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include "lomse_im_arena.h"
+
+#include <new>
+
+namespace lomse
+{
+
+//---------------------------------------------------------------------------------------
+// Each object is preceded by a header containing a pointer to the arena in which it
+// was allocated, or nullptr when allocated in the heap. The header size preserves
+// objects alignment.
+static const size_t k_header_size = ImArena::k_granularity;
+
+static thread_local ImArena* m_pCurrentArena = nullptr;
+
+
+//=======================================================================================
+// ImArena implementation
+//=======================================================================================
+ImArena::ImArena()
+    : m_freeSlots(k_max_slot_size / k_granularity, nullptr)
+{
+}
+
+//---------------------------------------------------------------------------------------
+ImArena::~ImArena()
+{
+    for (char* pChunk : m_chunks)
+        ::operator delete(pChunk);
+}
+
+//---------------------------------------------------------------------------------------
+void ImArena::release()
+{
+    //The owner will not use this arena any more. Objects still alive continue
+    //using their slots, and the arena will be deleted when the last one is deleted
+
+    m_fOwned = false;
+    if (m_numObjects == 0)
+        delete this;
+}
+
+//---------------------------------------------------------------------------------------
+void* ImArena::allocate(size_t size)
+{
+    //returns nullptr when the object is too big for the arena
+
+    size_t slotSize = (size + k_granularity - 1) & ~size_t(k_granularity - 1);
+    if (slotSize > k_max_slot_size)
+        return nullptr;
+
+    void* p;
+    size_t i = slotSize / k_granularity - 1;
+    if (m_freeSlots[i])
+    {
+        p = m_freeSlots[i];
+        m_freeSlots[i] = *static_cast<void**>(p);
+    }
+    else
+    {
+        if (m_available < slotSize)
+            add_chunk();
+
+        p = m_pNext;
+        m_pNext += slotSize;
+        m_available -= slotSize;
+    }
+
+    ++m_numObjects;
+    return p;
+}
+
+//---------------------------------------------------------------------------------------
+void ImArena::deallocate(void* p, size_t size)
+{
+    size_t slotSize = (size + k_granularity - 1) & ~size_t(k_granularity - 1);
+    size_t i = slotSize / k_granularity - 1;
+    *static_cast<void**>(p) = m_freeSlots[i];
+    m_freeSlots[i] = p;
+
+    if (--m_numObjects == 0 && !m_fOwned)
+        delete this;
+}
+
+//---------------------------------------------------------------------------------------
+void ImArena::add_chunk()
+{
+    //remaining space in previous chunk, if any, is lost
+
+    m_pNext = static_cast<char*>( ::operator new(k_chunk_size) );
+    m_chunks.push_back(m_pNext);
+    m_available = k_chunk_size;
+}
+
+//---------------------------------------------------------------------------------------
+ImArena* ImArena::get_current()
+{
+    return m_pCurrentArena;
+}
+
+//---------------------------------------------------------------------------------------
+void ImArena::set_current(ImArena* pArena)
+{
+    m_pCurrentArena = pArena;
+}
+
+//---------------------------------------------------------------------------------------
+void* ImArena::allocate_object(size_t size)
+{
+    size_t total = size + k_header_size;
+    ImArena* pArena = m_pCurrentArena;
+    void* pBlock = (pArena ? pArena->allocate(total) : nullptr);
+    if (!pBlock)
+    {
+        pBlock = ::operator new(total);
+        pArena = nullptr;
+    }
+
+    *static_cast<ImArena**>(pBlock) = pArena;
+    return static_cast<char*>(pBlock) + k_header_size;
+}
+
+//---------------------------------------------------------------------------------------
+void ImArena::deallocate_object(void* p, size_t size)
+{
+    if (!p)
+        return;
+
+    char* pBlock = static_cast<char*>(p) - k_header_size;
+    ImArena* pArena = *reinterpret_cast<ImArena**>(pBlock);
+    if (pArena)
+        pArena->deallocate(pBlock, size + k_header_size);
+    else
+        ::operator delete(pBlock);
+}
+
+//---------------------------------------------------------------------------------------
+ImArena* ImArena::get_arena_for(void* pObject)
+{
+    //Only valid for objects allocated with allocate_object()
+
+    return *reinterpret_cast<ImArena**>(static_cast<char*>(pObject) - k_header_size);
+}
+
+
+}   //namespace lomse
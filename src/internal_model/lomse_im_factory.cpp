@@ -29,6 +29,7 @@ ImoObj* ImFactory::inject(int type, Document* pDoc, ImoId id)
 ImoObj* ImFactory::inject(int type, DocModel* pDocModel, ImoId id)
 {
     ImoObj* pObj = nullptr;
+    ImArenaScope arena(pDocModel->get_arena());
 
     if (!(type > k_imo_dto && type < k_imo_dto_last))
         id = pDocModel->reserve_id(id);
@@ -283,8 +284,9 @@ ImoObj* ImFactory::clone(ImoObj* a)
 //---------------------------------------------------------------------------------------
 ImoBeamData* ImFactory::inject_beam_data(Document* pDoc, ImoBeamDto* pDto)
 {
-    ImoBeamData* pObj = LOMSE_NEW ImoBeamData(pDto);
     DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
+    ImoBeamData* pObj = LOMSE_NEW ImoBeamData(pDto);
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -293,8 +295,9 @@ ImoBeamData* ImFactory::inject_beam_data(Document* pDoc, ImoBeamDto* pDto)
 //---------------------------------------------------------------------------------------
 ImoTieData* ImFactory::inject_tie_data(Document* pDoc, ImoTieDto* pDto)
 {
-    ImoTieData* pObj = LOMSE_NEW ImoTieData(pDto);
     DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
+    ImoTieData* pObj = LOMSE_NEW ImoTieData(pDto);
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -303,8 +306,9 @@ ImoTieData* ImFactory::inject_tie_data(Document* pDoc, ImoTieDto* pDto)
 //---------------------------------------------------------------------------------------
 ImoSlurData* ImFactory::inject_slur_data(Document* pDoc, ImoSlurDto* pDto)
 {
-    ImoSlurData* pObj = LOMSE_NEW ImoSlurData(pDto);
     DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
+    ImoSlurData* pObj = LOMSE_NEW ImoSlurData(pDto);
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -313,9 +317,10 @@ ImoSlurData* ImFactory::inject_slur_data(Document* pDoc, ImoSlurDto* pDto)
 //---------------------------------------------------------------------------------------
 ImoTuplet* ImFactory::inject_tuplet(Document* pDoc, ImoTupletDto* pDto)
 {
+    DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
     ImoTuplet* pObj = LOMSE_NEW ImoTuplet(pDto);
     pObj->set_id( pDto->get_id() );
-    DocModel* pDocModel = pDoc->get_doc_model();
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -324,9 +329,10 @@ ImoTuplet* ImFactory::inject_tuplet(Document* pDoc, ImoTupletDto* pDto)
 //---------------------------------------------------------------------------------------
 ImoTextBox* ImFactory::inject_text_box(Document* pDoc, ImoTextBlockInfo& dto, ImoId id)
 {
+    DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
     ImoTextBox* pObj = LOMSE_NEW ImoTextBox(dto);
     pObj->set_id(id);
-    DocModel* pDocModel = pDoc->get_doc_model();
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -337,9 +343,10 @@ ImoNote* ImFactory::inject_note(Document* pDoc, int step, int octave,
                                 int noteType, EAccidentals accidentals,
                                 int dots, int staff, int voice, int stem)
 {
+    DocModel* pDocModel = pDoc->get_doc_model();
+    ImArenaScope arena(pDocModel->get_arena());
     ImoNote* pObj = LOMSE_NEW ImoNote(step, octave, noteType, accidentals, dots,
                                       staff, voice, stem);
-    DocModel* pDocModel = pDoc->get_doc_model();
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
     return pObj;
@@ -349,6 +356,7 @@ ImoNote* ImFactory::inject_note(Document* pDoc, int step, int octave,
 ImoImage* ImFactory::inject_image(DocModel* pDocModel, unsigned char* imgbuf, VSize bmpSize,
                                   EPixelFormat format, USize imgSize)
 {
+    ImArenaScope arena(pDocModel->get_arena());
     ImoImage* pObj = LOMSE_NEW ImoImage(imgbuf, bmpSize, format, imgSize);
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
@@ -358,6 +366,7 @@ ImoImage* ImFactory::inject_image(DocModel* pDocModel, unsigned char* imgbuf, VS
 //---------------------------------------------------------------------------------------
 ImoControl* ImFactory::inject_control(DocModel* pDocModel)
 {
+    ImArenaScope arena(pDocModel->get_arena());
     ImoControl* pObj = LOMSE_NEW ImoControl(k_imo_control);
     pDocModel->assign_id(pObj);
     pObj->set_owner_model(pDocModel);
@@ -1049,11 +1049,14 @@ void ImoObj::propagate_dirty()
         pParent->propagate_dirty();
     }
 
+    if (this->is_score())
+        static_cast<ImoScore*>(this)->set_structurized(false);
+
     if (this->is_document())
     {
         ImoDocument* pImoDoc = static_cast<ImoDocument*>(this);
         Document* pDoc = pImoDoc->get_the_document();
-        pDoc->set_dirty();
+        pDoc->set_dirty_by_object();
     }
 }
 
@@ -1081,6 +1084,12 @@ string ImoObj::to_string(bool fWithIds)
     return exporter.get_source(this);
 }
 
+//---------------------------------------------------------------------------------------
+ImArena* ImoObj::get_model_arena()
+{
+    return (m_pDocModel ? m_pDocModel->get_arena() : nullptr);
+}
+
 //---------------------------------------------------------------------------------------
 bool ImoObj::has_attributte(TIntAttribute idx)
 {
@@ -1158,6 +1167,7 @@ string ImoObj::get_string_attribute(TIntAttribute attrib)
 //---------------------------------------------------------------------------------------
 void ImoObj::set_color_attribute(TIntAttribute idx, Color value)
 {
+    ImArenaScope arena( get_model_arena() );
     AttrObj* pAttr = get_attribute(idx);
     if (pAttr)
     {
@@ -4214,6 +4224,7 @@ ImoScore& ImoScore::clone(const ImoScore& a)
     m_accidentalsModel = a.m_accidentalsModel;
     m_pColStaffObjs = nullptr;
     m_pMidiTable = nullptr;
+    m_fStructurized = a.m_fStructurized;
     m_scaling = a.m_scaling;
     m_systemInfoFirst = a.m_systemInfoFirst;
     m_systemInfoOther = a.m_systemInfoOther;
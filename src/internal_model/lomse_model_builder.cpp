@@ -23,6 +23,10 @@
 #include <math.h>       //round
 
 #include <algorithm>
+#include <atomic>
+#if (LOMSE_ENABLE_THREADS == 1)
+    #include <thread>
+#endif
 using namespace std;
 
 namespace lomse
@@ -30,7 +34,7 @@ namespace lomse
 
 
 //=======================================================================================
-// helper class for accessing scores
+// helper class for collecting the scores to structurize
 // AWARE: if in future there are more structurizable elements, modify this class as
 //        shown in commented sentences.
 //=======================================================================================
@@ -38,18 +42,24 @@ class VisitorForStructurizables : public Visitor<ImoScore>
 //                                , public Visitor<ImoOtherStructurizable>
 {
 protected:
-    ModelBuilder* m_builder;
+    std::vector<ImoObj*>& m_pending;
+    bool m_fAll;
 
 public:
-    VisitorForStructurizables(ModelBuilder* builder)
+    VisitorForStructurizables(std::vector<ImoObj*>& pending, bool fAll)
         : Visitor<ImoScore>()
         //, Visitor<ImoOtherStructurizable>()
-        , m_builder(builder)
+        , m_pending(pending)
+        , m_fAll(fAll)
     {
     }
 
-    void start_visit(ImoScore* pImo) override { m_builder->structurize(pImo); }
-    //void start_visit(ImoOtherStructurizable* pImo) { m_builder->structurize(pImo); }
+    void start_visit(ImoScore* pImo) override
+    {
+        if (m_fAll || !pImo->is_structurized())
+            m_pending.push_back(pImo);
+    }
+    //void start_visit(ImoOtherStructurizable* pImo) { m_pending.push_back(pImo); }
 
 	void end_visit(ImoScore* UNUSED(pImo)) override {}
     //void end_visit(ImoOtherStructurizable* pImo) {}
@@ -83,13 +93,49 @@ public:
 //=======================================================================================
 // ModelBuilder implementation
 //=======================================================================================
-ImoDocument* ModelBuilder::build_model(ImoDocument* pImoDoc)
+ImoDocument* ModelBuilder::build_model(ImoDocument* pImoDoc, bool fAllScores)
 {
-    if (pImoDoc)
+    //Only the scores modified since they were structurized are processed. All of them
+    //when requested or when the document was modified without marking the modified
+    //objects as dirty.
+    //Scores are independent. Therefore, when threads are enabled, several scores can
+    //be structurized at the same time. Each thread takes the next score not yet done.
+
+    if (!pImoDoc)
+        return pImoDoc;
+
+    Document* pDoc = pImoDoc->get_the_document();
+    bool fAll = fAllScores || (pDoc && pDoc->has_untracked_changes());
+
+    std::vector<ImoObj*> pending;
+    VisitorForStructurizables v(pending, fAll);
+    pImoDoc->accept_visitor(v);
+
+    size_t numScores = pending.size();
+    std::atomic<size_t> nextScore(0);
+
+    auto structurizeScores = [&]()
     {
-        VisitorForStructurizables v(this);
-        pImoDoc->accept_visitor(v);
-    }
+        for (size_t i = nextScore++; i < numScores; i = nextScore++)
+            structurize(pending[i]);
+    };
+
+#if (LOMSE_ENABLE_THREADS == 1)
+    int numThreads = max(1, int(std::thread::hardware_concurrency()));
+    numThreads = min(numThreads, int(numScores));
+
+    std::vector<std::thread> workers;
+    for (int i=1; i < numThreads; ++i)
+        workers.push_back( std::thread(structurizeScores) );
+
+    structurizeScores();
+
+    for (std::thread& t : workers)
+        t.join();
+#else
+    structurizeScores();
+#endif
+
     return pImoDoc;
 }
 
@@ -119,6 +165,8 @@ void ModelBuilder::structurize(ImoObj* pImo)
 
         GroupBarlinesFixer fixer;
         fixer.set_barline_layout_in_instruments(pScore);
+
+        pScore->set_structurized(true);
     }
 }
 
@@ -497,6 +545,7 @@ void MidiAssigner::collect_sounds_info(ImoScore* pScore)
         }
         else
         {
+            DocModelLock lock(pInstr->get_doc_model());
             ImoSoundInfo* pInfo = static_cast<ImoSoundInfo*>(
                                         ImFactory::inject(k_imo_sound_info, pInstr->get_doc_model()) );
             pInstr->add_sound_info(pInfo);
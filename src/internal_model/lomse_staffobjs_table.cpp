@@ -15,6 +15,7 @@
 #include "lomse_ldp_exporter.h"
 #include "lomse_time.h"
 #include "lomse_im_factory.h"
+#include "private/lomse_document_p.h"
 
 
 #include <sstream>
@@ -188,6 +189,7 @@ ColStaffObjs::ColStaffObjs()
     , m_num16th(0)
     , m_pFirst(nullptr)
     , m_pLast(nullptr)
+    , m_fMeasuresIndexValid(false)
 {
 }
 
@@ -207,6 +209,12 @@ ColStaffObjsEntry* ColStaffObjs::add_entry(int measure, int instr, int voice, in
         LOMSE_NEW ColStaffObjsEntry(measure, instr, voice, staff, pImo);
     add_entry_to_list(pEntry);
     ++m_numEntries;
+
+    m_entryForStaffObj[pImo] = pEntry;
+    ImoId id = pImo->get_id();
+    if (id != k_no_imoid)
+        m_entryForId[id] = pEntry;
+
     return pEntry;
 }
 
@@ -245,6 +253,8 @@ string ColStaffObjs::dump(bool fWithIds)
 //---------------------------------------------------------------------------------------
 void ColStaffObjs::add_entry_to_list(ColStaffObjsEntry* pEntry)
 {
+    m_fMeasuresIndexValid = false;
+
     if (!m_pFirst)
     {
         //first entry
@@ -252,11 +262,14 @@ void ColStaffObjs::add_entry_to_list(ColStaffObjsEntry* pEntry)
         m_pLast = pEntry;
         pEntry->set_prev( nullptr );
         pEntry->set_next( nullptr );
+        add_to_time_index(pEntry);
         return;
     }
 
-    //insert in list in order
-    ColStaffObjsEntry* pCurrent = m_pLast;
+    //insert in list in order. All entries with greater time than the new one would
+    //be skipped when searching backwards from the end, so start the search at the
+    //last entry that could be a valid insertion point
+    ColStaffObjsEntry* pCurrent = find_insertion_hint(pEntry);
     while (pCurrent != nullptr)
     {
         if (is_lower_entry(pEntry, pCurrent))
@@ -272,6 +285,7 @@ void ColStaffObjs::add_entry_to_list(ColStaffObjsEntry* pEntry)
                 m_pLast = pEntry;
             else
                 pNext->set_prev( pEntry );
+            add_to_time_index(pEntry);
             return;
         }
     }
@@ -281,6 +295,62 @@ void ColStaffObjs::add_entry_to_list(ColStaffObjsEntry* pEntry)
     pEntry->set_next( m_pFirst );
     m_pFirst->set_prev( pEntry );
     m_pFirst = pEntry;
+    add_to_time_index(pEntry);
+}
+
+//---------------------------------------------------------------------------------------
+ColStaffObjsEntry* ColStaffObjs::find_insertion_hint(ColStaffObjsEntry* pEntry)
+{
+    //Entries are ordered by time. Therefore, when searching backwards for the
+    //insertion point, all entries with time greater than the time of the new entry
+    //will be skipped (rule R1.1 in is_lower_entry()). This method returns the last
+    //entry that will not be skipped by rule R1.1, so that the search can start there.
+
+    TimeUnits time = pEntry->time();
+    map<TimeUnits, ColStaffObjsEntry*>::iterator it =
+        m_lastEntryAtTime.lower_bound(time + 0.1);
+    if (it == m_lastEntryAtTime.begin())
+        return nullptr;     //all entries have greater time
+
+    --it;
+    ColStaffObjsEntry* pHint = it->second;
+
+    //times with differences lower than the time tolerance could be not strictly
+    //ordered. Move to the last entry not having greater time.
+    while (pHint->get_next() && !is_lower_time(time, pHint->get_next()->time()))
+        pHint = pHint->get_next();
+
+    return pHint;
+}
+
+//---------------------------------------------------------------------------------------
+void ColStaffObjs::add_to_time_index(ColStaffObjsEntry* pEntry)
+{
+    //AWARE: The index assumes that staffobjs time is not modified while the
+    //staffobj is in the table. Table must be rebuilt or sorted after changing times.
+
+    TimeUnits time = pEntry->time();
+    map<TimeUnits, ColStaffObjsEntry*>::iterator it = m_lastEntryAtTime.find(time);
+    if (it == m_lastEntryAtTime.end())
+        m_lastEntryAtTime[time] = pEntry;
+    else if (it->second == pEntry->get_prev())
+        it->second = pEntry;
+}
+
+//---------------------------------------------------------------------------------------
+void ColStaffObjs::remove_from_time_index(ColStaffObjsEntry* pEntry)
+{
+    TimeUnits time = pEntry->time();
+    map<TimeUnits, ColStaffObjsEntry*>::iterator it = m_lastEntryAtTime.find(time);
+    if (it == m_lastEntryAtTime.end() || it->second != pEntry)
+        return;
+
+    //replace by previous entry if it has the same time
+    ColStaffObjsEntry* pPrev = pEntry->get_prev();
+    if (pPrev && pPrev->time() == time)
+        it->second = pPrev;
+    else
+        m_lastEntryAtTime.erase(it);
 }
 
 //---------------------------------------------------------------------------------------
@@ -401,6 +471,16 @@ void ColStaffObjs::delete_entry_for(ImoStaffObj* pSO)
         throw runtime_error("[ColStaffObjs::delete_entry_for] entry not found!");
     }
 
+    remove_from_time_index(pEntry);
+    m_entryForStaffObj.erase(pSO);
+    unordered_map<ImoId, ColStaffObjsEntry*>::iterator itId =
+        m_entryForId.find(pSO->get_id());
+    if (itId != m_entryForId.end() && itId->second == pEntry)
+        m_entryForId.erase(itId);
+    m_fMeasuresIndexValid = false;
+    if (pSO->get_colstaffobjs_entry() == pEntry)
+        pSO->set_colstaffobjs_entry(nullptr);
+
     ColStaffObjsEntry* pPrev = pEntry->get_prev();
     ColStaffObjsEntry* pNext = pEntry->get_next();
     delete pEntry;
@@ -429,13 +509,117 @@ void ColStaffObjs::delete_entry_for(ImoStaffObj* pSO)
 //---------------------------------------------------------------------------------------
 ColStaffObjsEntry* ColStaffObjs::find_entry_for(ImoStaffObj* pSO)
 {
-    ColStaffObjs::iterator it;
-    for (it=begin(); it != end(); ++it)
+    unordered_map<ImoStaffObj*, ColStaffObjsEntry*>::iterator it =
+        m_entryForStaffObj.find(pSO);
+    return (it != m_entryForStaffObj.end() ? it->second : nullptr);
+}
+
+//---------------------------------------------------------------------------------------
+ColStaffObjsEntry* ColStaffObjs::find_entry_for_id(ImoId id)
+{
+    unordered_map<ImoId, ColStaffObjsEntry*>::iterator it = m_entryForId.find(id);
+    if (it == m_entryForId.end())
+        return nullptr;
+
+    //staffobjs shared by several staves (e.g. key and time signatures) have an
+    //entry for each staff, all at the same time. Return the first one
+    ColStaffObjsEntry* pEntry = it->second;
+    for (ColStaffObjsEntry* pPrev = pEntry->get_prev();
+         pPrev && is_equal_time(pPrev->time(), pEntry->time());
+         pPrev = pPrev->get_prev())
     {
-        if ((*it)->imo_object() == pSO)
-            return *it;
+        if (pPrev->element_id() == id)
+            pEntry = pPrev;
     }
-    return nullptr;
+    return pEntry;
+}
+
+//---------------------------------------------------------------------------------------
+ColStaffObjsEntry* ColStaffObjs::first_entry_at_time(TimeUnits time)
+{
+    //Returns the first entry whose time is not lower than the requested time, or
+    //nullptr if all entries have lower time. The time index is used for skipping
+    //all entries with lower time.
+
+    map<TimeUnits, ColStaffObjsEntry*>::iterator it =
+        m_lastEntryAtTime.lower_bound(time - 1.0);
+
+    ColStaffObjsEntry* pEntry = m_pFirst;
+    if (it != m_lastEntryAtTime.begin())
+    {
+        --it;
+        pEntry = it->second->get_next();
+    }
+
+    while (pEntry && is_lower_time(pEntry->time(), time))
+        pEntry = pEntry->get_next();
+
+    return pEntry;
+}
+
+//---------------------------------------------------------------------------------------
+int ColStaffObjs::num_measures()
+{
+    if (!m_fMeasuresIndexValid)
+        build_measures_index();
+
+    return int(m_firstInMeasure.size());
+}
+
+//---------------------------------------------------------------------------------------
+ColStaffObjsEntry* ColStaffObjs::first_entry_in_measure(int measure)
+{
+    if (!m_fMeasuresIndexValid)
+        build_measures_index();
+
+    if (measure < 0 || measure >= int(m_firstInMeasure.size()))
+        return nullptr;
+    return m_firstInMeasure[measure];
+}
+
+//---------------------------------------------------------------------------------------
+ColStaffObjsEntry* ColStaffObjs::first_entry_in_measure(int instr, int measure)
+{
+    if (!m_fMeasuresIndexValid)
+        build_measures_index();
+
+    if (instr < 0 || instr >= int(m_firstInInstrMeasure.size()))
+        return nullptr;
+
+    vector<ColStaffObjsEntry*>& measures = m_firstInInstrMeasure[instr];
+    if (measure < 0 || measure >= int(measures.size()))
+        return nullptr;
+    return measures[measure];
+}
+
+//---------------------------------------------------------------------------------------
+void ColStaffObjs::build_measures_index()
+{
+    m_firstInMeasure.clear();
+    m_firstInInstrMeasure.clear();
+
+    for (ColStaffObjsEntry* pEntry = m_pFirst; pEntry; pEntry = pEntry->get_next())
+    {
+        int measure = pEntry->measure();
+        int instr = pEntry->num_instrument();
+        if (measure < 0 || instr < 0)
+            continue;
+
+        if (measure >= int(m_firstInMeasure.size()))
+            m_firstInMeasure.resize(measure + 1, nullptr);
+        if (m_firstInMeasure[measure] == nullptr)
+            m_firstInMeasure[measure] = pEntry;
+
+        if (instr >= int(m_firstInInstrMeasure.size()))
+            m_firstInInstrMeasure.resize(instr + 1);
+        vector<ColStaffObjsEntry*>& measures = m_firstInInstrMeasure[instr];
+        if (measure >= int(measures.size()))
+            measures.resize(measure + 1, nullptr);
+        if (measures[measure] == nullptr)
+            measures[measure] = pEntry;
+    }
+
+    m_fMeasuresIndexValid = true;
 }
 
 //---------------------------------------------------------------------------------------
@@ -453,6 +637,7 @@ void ColStaffObjs::sort_table()
     ColStaffObjsEntry* pUnsorted = m_pFirst;
     m_pFirst = nullptr;
     m_pLast = nullptr;
+    m_lastEntryAtTime.clear();
 
     while (pUnsorted != nullptr)
     {
@@ -1131,6 +1316,7 @@ void ColStaffObjsBuilderEngine1x::update_time_counter(ImoGoBackFwd* pGBF)
 ImoDirection* ColStaffObjsBuilderEngine1x::anchor_object(ImoAuxObj* pAux)
 {
     DocModel* pDocModel = m_pImScore->get_doc_model();
+    DocModelLock lock(pDocModel);
     ImoDirection* pAnchor =
             static_cast<ImoDirection*>(ImFactory::inject(k_imo_direction, pDocModel));
     pAnchor->add_attachment(pAux);
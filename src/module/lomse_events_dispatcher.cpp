@@ -17,28 +17,48 @@ namespace lomse
 //=======================================================================================
 // EventsDispatcher implementation
 //=======================================================================================
+EventsDispatcher::~EventsDispatcher()
+{
+    stop_events_loop();
+}
+
+//---------------------------------------------------------------------------------------
 void EventsDispatcher::start_events_loop()
 {
     //Create the thread. It starts inmediately to execute the events loop (method
     //run_events_loop())
 
     //AWARE: this method is only intended to be invoked by Lomse, when the library is
-    //initialized. This method only returns when the stop_events_loop() method
+    //initialized. The thread runs until the stop_events_loop() method
     //is invoked.
 
-    delete m_pThread;
+    stop_events_loop();
+    m_fStopLoop = false;
     m_pThread = LOMSE_NEW EventsThread(&EventsDispatcher::thread_main, this);
 }
 
 //---------------------------------------------------------------------------------------
 void EventsDispatcher::stop_events_loop()
 {
-    //stops the events dispatch loop
+    //stops the events dispatch loop and waits for the thread to finish. Pending
+    //events are discarded
 
     //AWARE: this method is only intended to be run by Lomse, when the
     //Lomse LibraryScope object is destroyed.
 
-    m_fStopLoop = true;
+    {
+        QueueLock lock(m_mutex);
+        m_fStopLoop = true;
+    }
+    m_wakeUp.notify_one();
+
+    if (m_pThread)
+    {
+        if (m_pThread->joinable())
+            m_pThread->join();
+        delete m_pThread;
+        m_pThread = nullptr;
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -50,41 +70,69 @@ void EventsDispatcher::thread_main()
 //---------------------------------------------------------------------------------------
 void EventsDispatcher::post_event(Observer* pObserver, SpEventInfo pEvent)
 {
-    QueueLock lock(m_mutex);
-    m_events.push( make_pair(pEvent, pObserver));
+    {
+        QueueLock lock(m_mutex);
+        if (coalesce_with_last_event(pObserver, pEvent))
+            return;
+        m_events.push( make_pair(pEvent, pObserver));
+    }
+    m_wakeUp.notify_one();
 }
 
 //---------------------------------------------------------------------------------------
-// Methods to be executed in the thread
-//---------------------------------------------------------------------------------------
-
-void EventsDispatcher::run_events_loop()
+bool EventsDispatcher::coalesce_with_last_event(Observer* pObserver, SpEventInfo pEvent)
 {
-    std::chrono::milliseconds waitTime(5);   //5ms
+    //AWARE: the queue must be locked when invoking this method.
+    //Only the last queued event is considered, to preserve events order.
+
+    if (m_events.empty() || !pEvent->is_tracking_event())
+        return false;
+
+    pair<SpEventInfo, Observer*>& last = m_events.back();
+    if (last.second != pObserver || !last.first->is_tracking_event())
+        return false;
+
+    SpEventVisualTracking pPending( static_pointer_cast<EventVisualTracking>(last.first) );
+    SpEventVisualTracking pNew( static_pointer_cast<EventVisualTracking>(pEvent) );
+    if (pPending->get_score_id() != pNew->get_score_id()
+        || pPending->get_interactor().lock() != pNew->get_interactor().lock())
+    {
+        return false;
+    }
 
-    while (!stop_event_received())
+    for (auto& item : pNew->get_items())
     {
-        if (pending_events())
-            dispatch_next_event();
+        if (item.first == EventVisualTracking::k_move_tempo_line)
+            pPending->add_move_tempo_line_event(pNew->get_timepos());
         else
-            std::this_thread::sleep_for(waitTime);
+            pPending->add_item(item.first, item.second);
     }
+    return true;
 }
 
 //---------------------------------------------------------------------------------------
-void EventsDispatcher::dispatch_next_event()
-{
-    pair<SpEventInfo, Observer*> event;
+// Methods to be executed in the thread
+//---------------------------------------------------------------------------------------
 
+void EventsDispatcher::run_events_loop()
+{
+    while (true)
     {
-        QueueLock lock(m_mutex);
-        event = m_events.front();
-        m_events.pop();
+        pair<SpEventInfo, Observer*> event;
+        {
+            QueueLock lock(m_mutex);
+            m_wakeUp.wait(lock, [this]{ return m_fStopLoop || !m_events.empty(); });
+            if (m_fStopLoop)
+                return;
+
+            event = m_events.front();
+            m_events.pop();
+        }
+
+        SpEventInfo pEvent = event.first;
+        Observer* pObserver = event.second;
+        pObserver->notify(pEvent);
     }
-
-    SpEventInfo pEvent = event.first;
-    Observer* pObserver = event.second;
-    pObserver->notify(pEvent);
 }
 
 #endif
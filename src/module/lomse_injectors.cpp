@@ -46,11 +46,31 @@
 #endif
 
 #include <sstream>
+#include <vector>
 using namespace std;
 
 namespace lomse
 {
 
+//---------------------------------------------------------------------------------------
+// FontStorage objects created by current thread, one for each LibraryScope. They are
+// deleted when the thread exits or when the LibraryScope is deleted in this thread.
+typedef std::vector< std::pair<long, FontStorage*> > ThreadFontStorages;
+static thread_local ThreadFontStorages* m_pThreadFontStorages = nullptr;
+static std::atomic<long> m_lastScopeId(0L);
+
+class ThreadFontStoragesOwner
+{
+public:
+    ~ThreadFontStoragesOwner()
+    {
+        for (auto& item : *m_pThreadFontStorages)
+            delete item.second;
+        delete m_pThreadFontStorages;
+        m_pThreadFontStorages = nullptr;
+    }
+};
+
 
 //=======================================================================================
 // LibraryScope implementation
@@ -60,7 +80,7 @@ LibraryScope::LibraryScope(ostream& reporter, LomseDoorway* pDoorway)
     , m_pDoorway(pDoorway)
     , m_pNullDoorway(nullptr)
     , m_pLdpFactory(nullptr)       //lazzy instantiation. Singleton scope.
-    , m_pFontStorage(nullptr)      //lazzy instantiation. Singleton scope.
+    , m_scopeId(++m_lastScopeId)   //FontStorage: lazzy instantiation. One per thread.
     , m_pFontSelector(nullptr)     //lazzy instantiation. Singleton scope.
     , m_pGlobalMetronome(nullptr)
     , m_pDispatcher(nullptr)
@@ -68,6 +88,7 @@ LibraryScope::LibraryScope(ostream& reporter, LomseDoorway* pDoorway)
     , m_sMusicFontName("Bravura")
     , m_sMusicFontPath(LOMSE_FONTS_PATH)
     , m_sFontsPath(LOMSE_FONTS_PATH)
+    , m_fontPathsRevision(0L)
     , m_pMusicGlyphs(nullptr)      //lazzy instantiation. Singleton scope.
     , m_fReplaceLocalMetronome(false)
     , m_importOptions()
@@ -99,7 +120,7 @@ LibraryScope::LibraryScope(ostream& reporter, LomseDoorway* pDoorway)
 LibraryScope::~LibraryScope()
 {
     delete m_pLdpFactory;
-    delete m_pFontStorage;
+    delete_font_storage();
     delete m_pFontSelector;
     delete m_pNullDoorway;
     delete m_pMusicGlyphs;
@@ -113,6 +134,7 @@ LibraryScope::~LibraryScope()
 //---------------------------------------------------------------------------------------
 LdpFactory* LibraryScope::ldp_factory()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (!m_pLdpFactory)
         m_pLdpFactory = LOMSE_NEW LdpFactory();
     return m_pLdpFactory;
@@ -121,14 +143,53 @@ LdpFactory* LibraryScope::ldp_factory()
 //---------------------------------------------------------------------------------------
 FontStorage* LibraryScope::font_storage()
 {
-    if (!m_pFontStorage)
-        m_pFontStorage = LOMSE_NEW FontStorage(this);
-    return m_pFontStorage;
+    //The font engine and its glyphs cache are not thread safe. Therefore, each
+    //thread uses its own FontStorage, so that several documents can be laid out
+    //and rendered in parallel. It is owned by the thread, so that it is released
+    //when the thread finishes, and no lock is needed.
+
+    if (!m_pThreadFontStorages)
+    {
+        static thread_local ThreadFontStoragesOwner owner;
+        m_pThreadFontStorages = LOMSE_NEW ThreadFontStorages();
+    }
+
+    for (auto& item : *m_pThreadFontStorages)
+    {
+        if (item.first == m_scopeId)
+            return item.second;
+    }
+
+    FontStorage* pStorage = LOMSE_NEW FontStorage(this);
+    m_pThreadFontStorages->push_back( make_pair(m_scopeId, pStorage) );
+    return pStorage;
+}
+
+//---------------------------------------------------------------------------------------
+void LibraryScope::delete_font_storage()
+{
+    //Deletes the FontStorage of current thread. Those of other threads are not
+    //accessed any more, and are deleted when those threads finish.
+
+    if (!m_pThreadFontStorages)
+        return;
+
+    ThreadFontStorages::iterator it;
+    for (it = m_pThreadFontStorages->begin(); it != m_pThreadFontStorages->end(); ++it)
+    {
+        if (it->first == m_scopeId)
+        {
+            delete it->second;
+            m_pThreadFontStorages->erase(it);
+            return;
+        }
+    }
 }
 
 //---------------------------------------------------------------------------------------
 FontSelector* LibraryScope::get_font_selector()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (!m_pFontSelector)
         m_pFontSelector = LOMSE_NEW FontSelector(this);
     return m_pFontSelector;
@@ -137,6 +198,7 @@ FontSelector* LibraryScope::get_font_selector()
 //---------------------------------------------------------------------------------------
 MusicGlyphs* LibraryScope::get_glyphs_table()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (!m_pMusicGlyphs)
         m_pMusicGlyphs = LOMSE_NEW MusicGlyphs(this);
     return m_pMusicGlyphs;
@@ -149,6 +211,7 @@ void LibraryScope::set_music_font(const string& fontFile, const string& fontName
     m_sMusicFontName = fontName;
     m_sMusicFontFile = fontFile;
     m_sMusicFontPath = path;
+    ++m_fontPathsRevision;
     //TODO: ensure that font path ends in path separator ("\" or "/" depending on platform)
 
     get_glyphs_table()->update();
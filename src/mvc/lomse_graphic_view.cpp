@@ -34,6 +34,11 @@
 #include "lomse_score_algorithms.h"
 #include "lomse_gm_measures_table.h"
 
+#include <atomic>
+#if (LOMSE_ENABLE_THREADS == 1)
+    #include <thread>
+#endif
+
 using namespace std;
 
 namespace lomse
@@ -140,6 +145,12 @@ GraphicView::GraphicView(LibraryScope& libraryScope, Drawer* pDrawer,
     , m_trackingEffect(k_tracking_highlight_notes)
     , m_print_ppi(0.0)
     , m_backgroundColor( Color(145, 156, 166) )
+    , m_fBackgroundValid(false)
+    , m_bgModelId(-1L)
+    , m_bgRevision(-1L)
+    , m_bgVxOrg(0)
+    , m_bgVyOrg(0)
+    , m_bgTransform()
     , m_pScrollSystem(nullptr)
     , m_xScrollLeft(0.0f)
     , m_xScrollRight(0.0f)
@@ -837,6 +848,70 @@ void GraphicView::print_page(int page, VPoint viewport)
     }
 }
 
+//---------------------------------------------------------------------------------------
+void GraphicView::print_pages(const std::vector<int>& pages,
+                              const std::vector<unsigned char*>& buffers,
+                              unsigned width, unsigned height, VPoint viewport,
+                              int numThreads)
+{
+    //Pages are independent. Therefore, each page is rendered by its own drawer on its
+    //own buffer and several pages can be rendered at the same time. Each thread takes
+    //the next page not yet rendered.
+
+    size_t numPages = min(pages.size(), buffers.size());
+    if (numPages == 0)
+        return;
+
+    GraphicModel* pGModel = get_graphic_model();    //layout must be done before
+
+    //drawing bounds are computed the first time they are needed and saved in the
+    //boxes. Compute them now, so that threads only read them
+    for (size_t i=0; i < numPages; ++i)
+    {
+        GmoBoxDocPage* pPage = pGModel->get_page(pages[i]);
+        if (pPage)
+            pPage->get_drawing_bounds();
+    }
+
+    std::atomic<size_t> nextPage(0);
+
+    auto renderPages = [&]()
+    {
+        BitmapDrawer drawer(m_libraryScope);
+        TransAffine transform = m_printTransform;
+        drawer.set_affine_transformation(transform);
+
+        for (size_t i = nextPage++; i < numPages; i = nextPage++)
+        {
+            drawer.set_rendering_buffer(buffers[i], width, height);
+            drawer.new_viewport_size(double(width), double(height));
+            drawer.new_viewport_origin(double(viewport.x), double(viewport.y));
+            drawer.reset(Color(255, 255, 255));
+
+            UPoint origin(0.0f, 0.0f);
+            pGModel->draw_page(pages[i], origin, &drawer, m_options);
+            drawer.render();
+        }
+    };
+
+#if (LOMSE_ENABLE_THREADS == 1)
+    if (numThreads <= 0)
+        numThreads = max(1, int(std::thread::hardware_concurrency()));
+    numThreads = min(numThreads, int(numPages));
+
+    std::vector<std::thread> workers;
+    for (int i=1; i < numThreads; ++i)
+        workers.push_back( std::thread(renderPages) );
+
+    renderPages();
+
+    for (std::thread& t : workers)
+        t.join();
+#else
+    renderPages();
+#endif
+}
+
 //---------------------------------------------------------------------------------------
 void GraphicView::set_print_page_size(Pixels width, Pixels height)
 {
@@ -853,6 +928,7 @@ void GraphicView::set_print_page_size(Pixels width, Pixels height)
     affTransform.scale(scale);
 
     //set scale
+    m_printTransform = affTransform;
     m_pPrintDrawer->set_affine_transformation(affTransform);
 }
 
@@ -861,6 +937,29 @@ void GraphicView::draw_graphic_model()
 {
     LOMSE_LOG_DEBUG(Logger::k_mvc, string(""));
 
+    if (update_render_options())
+        invalidate_background();
+
+    if (!draw_graphic_model_incrementally())
+    {
+        m_pDrawer->reset(m_options.background_color);
+        m_pDrawer->new_viewport_origin(double(m_vxOrg), double(m_vyOrg));
+        m_pDrawer->set_affine_transformation(m_transform);
+
+        generate_paths();
+        m_pDrawer->render();
+    }
+
+    save_background_info();
+}
+
+//---------------------------------------------------------------------------------------
+bool GraphicView::update_render_options()
+{
+    //returns true if any option has changed
+
+    RenderOptions prev = m_options;
+
     m_options.background_color = m_backgroundColor;
     m_options.page_border_flag = true;
     m_options.cast_shadow_flag = true;
@@ -873,12 +972,91 @@ void GraphicView::draw_graphic_model()
     m_options.read_only_mode =
         m_pInteractor->get_operating_mode() != Interactor::k_mode_edition;
 
-    m_pDrawer->reset(m_options.background_color);
+    return is_different(prev.background_color, m_options.background_color)
+        || prev.draw_anchor_objects != m_options.draw_anchor_objects
+        || prev.draw_anchor_lines != m_options.draw_anchor_lines
+        || prev.draw_shape_bounds != m_options.draw_shape_bounds
+        || prev.draw_slur_points != m_options.draw_slur_points
+        || prev.draw_vertical_profile != m_options.draw_vertical_profile
+        || prev.draw_chords_coloured != m_options.draw_chords_coloured
+        || prev.read_only_mode != m_options.read_only_mode;
+}
+
+//---------------------------------------------------------------------------------------
+bool GraphicView::draw_graphic_model_incrementally()
+{
+    //When the graphic model and the rendering parameters are the same than in
+    //previous renderization, the rendering buffer content is reused: it is moved
+    //to the new viewport origin and only the uncovered areas are rendered.
+    //Returns false if a full renderization is needed.
+
+    BitmapDrawer* pDrawer = dynamic_cast<BitmapDrawer*>(m_pDrawer);
+    GraphicModel* pGModel = get_graphic_model();
+    if (!m_fBackgroundValid || !pDrawer || !pGModel
+        || !pDrawer->is_view_area_full_buffer()
+        || pGModel->get_model_id() != m_bgModelId
+        || pGModel->get_revision() != m_bgRevision
+        || m_transform.sx != m_bgTransform.sx || m_transform.sy != m_bgTransform.sy
+        || m_transform.shx != m_bgTransform.shx || m_transform.shy != m_bgTransform.shy)
+    {
+        return false;
+    }
+
+    Pixels width = Pixels( pDrawer->get_rendering_buffer_width() );
+    Pixels height = Pixels( pDrawer->get_rendering_buffer_height() );
+    Pixels dx = m_bgVxOrg - m_vxOrg;
+    Pixels dy = m_bgVyOrg - m_vyOrg;
+    if (abs(dx) >= width || abs(dy) >= height)
+        return false;
+
+    //remove visual effects
+    if (!m_pOverlaysGenerator->restore_background())
+        return false;
+
     m_pDrawer->new_viewport_origin(double(m_vxOrg), double(m_vyOrg));
     m_pDrawer->set_affine_transformation(m_transform);
+    if (dx == 0 && dy == 0)
+        return true;
 
-    generate_paths();
+    pDrawer->scroll_view_area(dx, dy);
+    if (dy > 0)
+        draw_area(pDrawer, 0, 0, width, dy);
+    else if (dy < 0)
+        draw_area(pDrawer, 0, height + dy, width, height);
+
+    if (dx > 0)
+        draw_area(pDrawer, 0, 0, dx, height);
+    else if (dx < 0)
+        draw_area(pDrawer, width + dx, 0, width, height);
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+void GraphicView::draw_area(BitmapDrawer* pDrawer, Pixels x1, Pixels y1,
+                            Pixels x2, Pixels y2)
+{
+    pDrawer->begin_partial_render(x1, y1, x2, y2, m_options.background_color);
+    generate_paths( VRect(VPoint(x1, y1), VPoint(x2, y2)) );
     m_pDrawer->render();
+    pDrawer->end_partial_render();
+}
+
+//---------------------------------------------------------------------------------------
+void GraphicView::save_background_info()
+{
+    //the rendering buffer content can only be reused if the whole buffer was rendered
+    BitmapDrawer* pDrawer = dynamic_cast<BitmapDrawer*>(m_pDrawer);
+    GraphicModel* pGModel = get_graphic_model();
+    m_fBackgroundValid = pDrawer && pGModel && pDrawer->is_view_area_full_buffer();
+    if (pGModel)
+    {
+        m_bgModelId = pGModel->get_model_id();
+        m_bgRevision = pGModel->get_revision();
+    }
+    m_bgVxOrg = m_vxOrg;
+    m_bgVyOrg = m_vyOrg;
+    m_bgTransform = m_transform;
 }
 
 //---------------------------------------------------------------------------------------
@@ -1549,6 +1727,7 @@ bool GraphicView::shift_up_y_to_be_on_page(double* yBottom)
 //---------------------------------------------------------------------------------------
 void GraphicView::set_rendering_option(int option, bool value)
 {
+    invalidate_background();
     switch(option)
     {
         case k_option_draw_box_doc_page_content:
@@ -1586,18 +1765,22 @@ void GraphicView::set_rendering_option(int option, bool value)
 //---------------------------------------------------------------------------------------
 void GraphicView::reset_boxes_to_draw()
 {
+    invalidate_background();
     m_options.reset_boxes_to_draw();
 }
 
 //---------------------------------------------------------------------------------------
 void GraphicView::set_box_to_draw(int boxType)
 {
+    invalidate_background();
     m_options.draw_box_for(boxType);
 }
 
 //---------------------------------------------------------------------------------------
 void GraphicView::highlight_voice(int voice)
 {
+    if (m_options.highlighted_voice != voice)
+        invalidate_background();
     m_options.highlighted_voice = voice;
 }
 
@@ -1615,23 +1798,29 @@ void GraphicView::change_cursor_voice(int voice)
 
 //---------------------------------------------------------------------------------------
 void GraphicView::generate_paths()
+{
+    generate_paths( VRect(0, 0, m_viewportSize.width, m_viewportSize.height) );
+}
+
+//---------------------------------------------------------------------------------------
+void GraphicView::generate_paths(const VRect& area)
 {
     collect_page_bounds();      //moved out of 'if' block for unit tests
     if (is_valid_viewport())
     {
         int minPage, maxPage;
 
-        determine_visible_pages(&minPage, &maxPage);
-        draw_visible_pages(minPage, maxPage);
+        determine_visible_pages(area, &minPage, &maxPage);
+        draw_visible_pages(minPage, maxPage, area);
     }
 }
 
 //---------------------------------------------------------------------------------------
-void GraphicView::determine_visible_pages(int* minPage, int* maxPage)
+void GraphicView::determine_visible_pages(const VRect& area, int* minPage, int* maxPage)
 {
     list<PageRectangle*> rectangles;
-    screen_rectangle_to_page_rectangles(0, 0, m_viewportSize.width,
-                                        m_viewportSize.height, &rectangles);
+    screen_rectangle_to_page_rectangles(area.left(), area.top(), area.right(),
+                                        area.bottom(), &rectangles);
 
     if (!rectangles.empty())
     {
@@ -1656,19 +1845,41 @@ void GraphicView::delete_rectangles(list<PageRectangle*>& rectangles)
 }
 
 //---------------------------------------------------------------------------------------
-void GraphicView::draw_visible_pages(int minPage, int maxPage)
+void GraphicView::draw_visible_pages(int minPage, int maxPage, const VRect& area)
 {
     GraphicModel* pGModel = get_graphic_model();
 
+    //determine the visible area, so that objects outside it can be skipped. A small
+    //margin is added for line widths and anti-aliasing
+    double xLeft = double(area.left());
+    double yTop = double(area.top());
+    double xRight = double(area.right());
+    double yBottom = double(area.bottom());
+    m_pDrawer->device_point_to_model(&xLeft, &yTop);
+    m_pDrawer->device_point_to_model(&xRight, &yBottom);
+    normalize_rectangle(&xLeft, &yTop, &xRight, &yBottom);
+    LUnits margin = m_pDrawer->device_units_to_model(10.0);
+    URect visible(LUnits(xLeft) - margin, LUnits(yTop) - margin,
+                  LUnits(xRight - xLeft) + 2.0f * margin,
+                  LUnits(yBottom - yTop) + 2.0f * margin);
+
     list<URect>::iterator it = m_pageBounds.begin();
     for (int i=0; i < minPage; i++)
         ++it;
 
+    m_options.use_clip_rect = true;
     for (int i=minPage; i <= maxPage; i++, ++it)
     {
         UPoint origin = (*it).get_top_left();
+
+        //page content is positioned relative to page origin
+        m_options.clip_rect = visible;
+        m_options.clip_rect.x -= origin.x;
+        m_options.clip_rect.y -= origin.y;
+
         pGModel->draw_page(i, origin, m_pDrawer, m_options);
     }
+    m_options.use_clip_rect = false;
 }
 
 //---------------------------------------------------------------------------------------
@@ -1691,6 +1902,7 @@ UPoint GraphicView::get_page_origin_for(int iPage)
 //---------------------------------------------------------------------------------------
 void GraphicView::set_rendering_buffer(unsigned char* buf, unsigned width, unsigned height)
 {
+    invalidate_background();
     if (m_viewportSize.width != int(width))
         m_fUpdateGModel = true;
 
@@ -1722,6 +1934,8 @@ void GraphicView::set_rendering_buffer(RenderingBuffer* rbuf)
 {
     //DEPRECATED method Jan/2021
 
+    invalidate_background();
+
     if (m_viewportSize.width != int(rbuf->width()))
         m_fUpdateGModel = true;
 
@@ -1578,6 +1578,17 @@ void Interactor::print_page(int page, VPoint viewport)
         pGView->print_page(page, viewport);
 }
 
+//---------------------------------------------------------------------------------------
+void Interactor::print_pages(const std::vector<int>& pages,
+                             const std::vector<unsigned char*>& buffers,
+                             unsigned width, unsigned height, VPoint viewport,
+                             int numThreads)
+{
+    GraphicView* pGView = dynamic_cast<GraphicView*>(m_pView);
+    if (pGView)
+        pGView->print_pages(pages, buffers, width, height, viewport, numThreads);
+}
+
 //---------------------------------------------------------------------------------------
 int Interactor::get_num_pages()
 {
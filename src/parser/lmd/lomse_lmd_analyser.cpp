@@ -5830,6 +5830,7 @@ ImoObj* LmdAnalyser::analyse_tree_and_get_object(XmlNode* root)
 {
     //TODO_X
     delete_relation_builders();
+    m_analysers.reset();
     m_pTiesBuilder = LOMSE_NEW LmdTiesBuilder(m_reporter, this);
     m_pOldTiesBuilder = LOMSE_NEW OldLmdTiesBuilder(m_reporter, this);
     m_pBeamsBuilder = LOMSE_NEW LmdBeamsBuilder(m_reporter, this);
@@ -5861,7 +5862,7 @@ ImoObj* LmdAnalyser::analyse_node(XmlNode* pNode, ImoObj* pAnchor)
 {
     LmdElementAnalyser* a = new_analyser( pNode->name(), pAnchor );
     ImoObj* pImo = a->analyse_node(pNode);
-    delete a;
+    delete_analyser(a);
     return pImo;
 }
 
@@ -6173,93 +6174,100 @@ EAccidentals LmdAnalyser::to_accidentals(const std::string& accidentals)
 //---------------------------------------------------------------------------------------
 LmdElementAnalyser* LmdAnalyser::new_analyser(const string& name, ImoObj* pAnchor)
 {
-    //Factory method to create analysers
+    //Factory method to create analysers. Created analysers must be deleted
+    //by invoking delete_analyser()
 
     switch ( name_to_tag(name) )
     {
-//        case k_tag_abbrev:          return LOMSE_NEW InstrNameLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_anchorLine:      return LOMSE_NEW AnchorLineLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_barline:         return LOMSE_NEW BarlineLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_beam:            return LOMSE_NEW BeamLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_bezier:          return LOMSE_NEW BezierLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_border:          return LOMSE_NEW BorderLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_chord:           return LOMSE_NEW ChordLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_clef:            return LOMSE_NEW ClefLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_content:         return LOMSE_NEW ContentLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-////        case k_tag_creationMode:    return LOMSE_NEW ContentLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_color:           return LOMSE_NEW ColorLmdAnalyser(this, m_reporter, m_libraryScope);
-//        case k_tag_cursor:          return LOMSE_NEW CursorLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_defineStyle:     return LOMSE_NEW DefineStyleLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_endPoint:        return LOMSE_NEW PointLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_dynamic:         return LOMSE_NEW DynamicLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_fermata:         return LOMSE_NEW FermataLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_figuredBass:     return LOMSE_NEW FiguredBassLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_font:            return LOMSE_NEW FontLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_goBack:          return LOMSE_NEW GoBackFwdLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_goFwd:           return LOMSE_NEW GoBackFwdLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_group:           return LOMSE_NEW GroupLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_image:           return LOMSE_NEW ImageLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_itemizedlist:    return LOMSE_NEW ListLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_infoMIDI:        return LOMSE_NEW InfoMidiLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_instrument:      return LOMSE_NEW InstrumentLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_key_signature:   return LOMSE_NEW KeySignatureLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_ldpmusic:        return LOMSE_NEW LdpmusicLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_lenmusdoc:       return LOMSE_NEW LenmusdocLmdAnalyser(this, m_reporter, m_libraryScope);
-//        case k_tag_line:            return LOMSE_NEW LineLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_link:            return LOMSE_NEW LinkLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_listitem:        return LOMSE_NEW ListItemLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_metronome:       return LOMSE_NEW MetronomeLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_musicData:       return LOMSE_NEW MusicDataLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_na:              return LOMSE_NEW NoteRestLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_newSystem:       return LOMSE_NEW ControlLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_note:            return LOMSE_NEW NoteRestLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_opt:             return LOMSE_NEW OptLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_orderedlist:     return LOMSE_NEW ListLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_pageLayout:      return LOMSE_NEW PageLayoutLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_pageMargins:     return LOMSE_NEW PageMarginsLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_pageSize:        return LOMSE_NEW PageSizeLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_para:            return LOMSE_NEW ParagraphLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_param:           return LOMSE_NEW ParamLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_parts:           return LOMSE_NEW PartsLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_rest:            return LOMSE_NEW NoteRestLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_settings:        return LOMSE_NEW SettingsLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_score:           return LOMSE_NEW ScoreLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_scorePlayer:     return LOMSE_NEW ScorePlayerLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_section:         return LOMSE_NEW SectionLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_size:            return LOMSE_NEW SizeLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_slur:            return LOMSE_NEW SlurLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_spacer:          return LOMSE_NEW SpacerLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_staff:           return LOMSE_NEW StaffLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-////        case k_tag_symbol:          return LOMSE_NEW XxxxxxxLmdAnalyser(this, m_reporter, m_libraryScope);
-////        case k_tag_symbolSize:      return LOMSE_NEW XxxxxxxLmdAnalyser(this, m_reporter, m_libraryScope);
-//        case k_tag_startPoint:      return LOMSE_NEW PointLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_styles:          return LOMSE_NEW StylesLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_systemLayout:    return LOMSE_NEW SystemLayoutLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_systemMargins:   return LOMSE_NEW SystemMarginsLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_table:           return LOMSE_NEW TableLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_tableCell:       return LOMSE_NEW TableCellLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_tableColumn:     return LOMSE_NEW TableColumnLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_tableBody:       return LOMSE_NEW TableBodyLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_tableHead:       return LOMSE_NEW TableHeadLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_tableRow:        return LOMSE_NEW TableRowLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_tag_txt:             return LOMSE_NEW TextItemLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_text:            return LOMSE_NEW TextStringLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_textbox:         return LOMSE_NEW TextBoxLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_time_signature:  return LOMSE_NEW TimeSignatureLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_tie:             return LOMSE_NEW TieLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_title:           return LOMSE_NEW TitleLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_tag_tuplet:          return LOMSE_NEW TupletLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-////        case k_tag_undoData:        return LOMSE_NEW XxxxxxxLmdAnalyser(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_abbrev:          return m_analysers.create<InstrNameLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_anchorLine:      return m_analysers.create<AnchorLineLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_barline:         return m_analysers.create<BarlineLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_beam:            return m_analysers.create<BeamLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_bezier:          return m_analysers.create<BezierLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_border:          return m_analysers.create<BorderLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_chord:           return m_analysers.create<ChordLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_clef:            return m_analysers.create<ClefLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_content:         return m_analysers.create<ContentLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+////        case k_tag_creationMode:    return m_analysers.create<ContentLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_color:           return m_analysers.create<ColorLmdAnalyser>(this, m_reporter, m_libraryScope);
+//        case k_tag_cursor:          return m_analysers.create<CursorLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_defineStyle:     return m_analysers.create<DefineStyleLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_endPoint:        return m_analysers.create<PointLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_dynamic:         return m_analysers.create<DynamicLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_fermata:         return m_analysers.create<FermataLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_figuredBass:     return m_analysers.create<FiguredBassLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_font:            return m_analysers.create<FontLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_goBack:          return m_analysers.create<GoBackFwdLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_goFwd:           return m_analysers.create<GoBackFwdLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_group:           return m_analysers.create<GroupLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_image:           return m_analysers.create<ImageLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_itemizedlist:    return m_analysers.create<ListLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_infoMIDI:        return m_analysers.create<InfoMidiLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_instrument:      return m_analysers.create<InstrumentLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_key_signature:   return m_analysers.create<KeySignatureLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_ldpmusic:        return m_analysers.create<LdpmusicLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_lenmusdoc:       return m_analysers.create<LenmusdocLmdAnalyser>(this, m_reporter, m_libraryScope);
+//        case k_tag_line:            return m_analysers.create<LineLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_link:            return m_analysers.create<LinkLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_listitem:        return m_analysers.create<ListItemLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_metronome:       return m_analysers.create<MetronomeLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_musicData:       return m_analysers.create<MusicDataLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_na:              return m_analysers.create<NoteRestLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_newSystem:       return m_analysers.create<ControlLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_note:            return m_analysers.create<NoteRestLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_opt:             return m_analysers.create<OptLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_orderedlist:     return m_analysers.create<ListLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_pageLayout:      return m_analysers.create<PageLayoutLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_pageMargins:     return m_analysers.create<PageMarginsLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_pageSize:        return m_analysers.create<PageSizeLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_para:            return m_analysers.create<ParagraphLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_param:           return m_analysers.create<ParamLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_parts:           return m_analysers.create<PartsLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_rest:            return m_analysers.create<NoteRestLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_settings:        return m_analysers.create<SettingsLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_score:           return m_analysers.create<ScoreLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_scorePlayer:     return m_analysers.create<ScorePlayerLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_section:         return m_analysers.create<SectionLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_size:            return m_analysers.create<SizeLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_slur:            return m_analysers.create<SlurLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_spacer:          return m_analysers.create<SpacerLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_staff:           return m_analysers.create<StaffLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+////        case k_tag_symbol:          return m_analysers.create<XxxxxxxLmdAnalyser>(this, m_reporter, m_libraryScope);
+////        case k_tag_symbolSize:      return m_analysers.create<XxxxxxxLmdAnalyser>(this, m_reporter, m_libraryScope);
+//        case k_tag_startPoint:      return m_analysers.create<PointLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_styles:          return m_analysers.create<StylesLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_systemLayout:    return m_analysers.create<SystemLayoutLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_systemMargins:   return m_analysers.create<SystemMarginsLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_table:           return m_analysers.create<TableLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_tableCell:       return m_analysers.create<TableCellLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_tableColumn:     return m_analysers.create<TableColumnLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_tableBody:       return m_analysers.create<TableBodyLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_tableHead:       return m_analysers.create<TableHeadLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_tableRow:        return m_analysers.create<TableRowLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_tag_txt:             return m_analysers.create<TextItemLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_text:            return m_analysers.create<TextStringLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_textbox:         return m_analysers.create<TextBoxLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_time_signature:  return m_analysers.create<TimeSignatureLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_tie:             return m_analysers.create<TieLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_title:           return m_analysers.create<TitleLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_tag_tuplet:          return m_analysers.create<TupletLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+////        case k_tag_undoData:        return m_analysers.create<XxxxxxxLmdAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
 
         default:
-            return LOMSE_NEW NullLmdAnalyser(this, m_reporter, m_libraryScope, name);
+            return m_analysers.create<NullLmdAnalyser>(this, m_reporter, m_libraryScope, name);
     }
 }
 
+//---------------------------------------------------------------------------------------
+void LmdAnalyser::delete_analyser(LmdElementAnalyser* a)
+{
+    m_analysers.release(a);
+}
+
 //---------------------------------------------------------------------------------------
 int LmdAnalyser::name_to_tag(const string& name) const
 {
-	map<string, int>::const_iterator it = m_NameToTag.find(name);
+	auto it = m_NameToTag.find(name);
 	if (it != m_NameToTag.end())
 		return it->second;
     else
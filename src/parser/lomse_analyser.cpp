@@ -25,4 +25,29 @@ Analyser::~Analyser()
 }
 
 
+//=======================================================================================
+// ElementAnalysersMemory implementation
+//=======================================================================================
+ElementAnalysersMemory::ElementAnalysersMemory()
+    : m_level(0)
+{
+}
+
+//---------------------------------------------------------------------------------------
+ElementAnalysersMemory::~ElementAnalysersMemory()
+{
+    for (void* pBuffer : m_buffers)
+        ::operator delete(pBuffer);
+}
+
+//---------------------------------------------------------------------------------------
+void* ElementAnalysersMemory::next_buffer()
+{
+    if (m_level == int(m_buffers.size()))
+        m_buffers.push_back( ::operator new(k_buffer_size) );
+
+    return m_buffers[m_level++];
+}
+
+
 }   //namespace lomse
@@ -853,7 +853,7 @@ bool MnxElementAnalyser::analyse_content(const string& tag, ImoObj* pAnchor)
 {
     MnxElementAnalyser* a = m_pAnalyser->new_analyser(tag, pAnchor);
     bool ret = a->analyse_node(&m_analysedNode);
-    delete a;
+    m_pAnalyser->delete_analyser(a);
     return ret;
 }
 
@@ -4813,6 +4813,7 @@ void MnxAnalyser::delete_relation_builders()
 ImoObj* MnxAnalyser::analyse_tree_and_get_object(XmlNode* root)
 {
     delete_relation_builders();
+    m_analysers.reset();
     m_pTupletsBuilder = LOMSE_NEW MnxTupletsBuilder(m_reporter, this);
     m_pSlursBuilder = LOMSE_NEW MnxSlursBuilder(m_reporter, this);
     m_pVoltasBuilder = LOMSE_NEW MnxVoltasBuilder(m_reporter, this);
@@ -4839,7 +4840,7 @@ bool MnxAnalyser::analyse_node(XmlNode* pNode, ImoObj* pAnchor)
     MnxElementAnalyser* a = new_analyser( pNode->name(), pAnchor );
     set_result(nullptr);
     bool res = a->analyse_node(pNode);
-    delete a;
+    delete_analyser(a);
     return res;
 }
 
@@ -5197,50 +5198,57 @@ bool MnxAnalyser::to_integer(const string& text, int* pResult)
 //---------------------------------------------------------------------------------------
 MnxElementAnalyser* MnxAnalyser::new_analyser(const string& name, ImoObj* pAnchor)
 {
-    //Factory method to create analysers
+    //Factory method to create analysers. Created analysers must be deleted
+    //by invoking delete_analyser()
 
     switch ( name_to_enum(name) )
     {
-        case k_mnx_tag_beam:                return LOMSE_NEW BeamMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_beam_hook:           return LOMSE_NEW BeamHookMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_beams:               return LOMSE_NEW BeamsMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_clef:                return LOMSE_NEW ClefMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_directions:          return LOMSE_NEW DirectionsMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_dynamics:            return LOMSE_NEW DynamicsMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_event:               return LOMSE_NEW EventMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_expression:          return LOMSE_NEW ExpressionMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_fine:                return LOMSE_NEW FineMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_global:              return LOMSE_NEW GlobalMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_grace:               return LOMSE_NEW GraceMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_head:                return LOMSE_NEW HeadMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_instrument_sound:    return LOMSE_NEW InstrumentSoundMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_jump:                return LOMSE_NEW JumpMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_key:                 return LOMSE_NEW KeyMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_measure:             return LOMSE_NEW MeasureMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_mnx:                 return LOMSE_NEW MnxMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_note:                return LOMSE_NEW NoteMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_octave_shift:        return LOMSE_NEW OctaveShiftMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_part:                return LOMSE_NEW PartMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_part_name:           return LOMSE_NEW PartNameMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_repeat:              return LOMSE_NEW RepeatMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_rest:                return LOMSE_NEW RestMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_segno:               return LOMSE_NEW SegnoMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_sequence:            return LOMSE_NEW SequenceMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_sequence_content:    return LOMSE_NEW SequenceContentMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_staff:               return LOMSE_NEW StaffMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_tied:                return LOMSE_NEW TiedMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_time:                return LOMSE_NEW TimeMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_tuplet:              return LOMSE_NEW TupletMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mnx_tag_wedge:               return LOMSE_NEW WedgeMnxAnalyser(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_beam:                return m_analysers.create<BeamMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_beam_hook:           return m_analysers.create<BeamHookMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_beams:               return m_analysers.create<BeamsMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_clef:                return m_analysers.create<ClefMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_directions:          return m_analysers.create<DirectionsMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_dynamics:            return m_analysers.create<DynamicsMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_event:               return m_analysers.create<EventMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_expression:          return m_analysers.create<ExpressionMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_fine:                return m_analysers.create<FineMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_global:              return m_analysers.create<GlobalMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_grace:               return m_analysers.create<GraceMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_head:                return m_analysers.create<HeadMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_instrument_sound:    return m_analysers.create<InstrumentSoundMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_jump:                return m_analysers.create<JumpMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_key:                 return m_analysers.create<KeyMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_measure:             return m_analysers.create<MeasureMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_mnx:                 return m_analysers.create<MnxMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_note:                return m_analysers.create<NoteMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_octave_shift:        return m_analysers.create<OctaveShiftMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_part:                return m_analysers.create<PartMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_part_name:           return m_analysers.create<PartNameMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_repeat:              return m_analysers.create<RepeatMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_rest:                return m_analysers.create<RestMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_segno:               return m_analysers.create<SegnoMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_sequence:            return m_analysers.create<SequenceMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_sequence_content:    return m_analysers.create<SequenceContentMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_staff:               return m_analysers.create<StaffMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_tied:                return m_analysers.create<TiedMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_time:                return m_analysers.create<TimeMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_tuplet:              return m_analysers.create<TupletMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mnx_tag_wedge:               return m_analysers.create<WedgeMnxAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
         default:
-            return LOMSE_NEW NullMnxAnalyser(this, m_reporter, m_libraryScope, name);
+            return m_analysers.create<NullMnxAnalyser>(this, m_reporter, m_libraryScope, name);
     }
 }
 
+//---------------------------------------------------------------------------------------
+void MnxAnalyser::delete_analyser(MnxElementAnalyser* a)
+{
+    m_analysers.release(a);
+}
+
 //---------------------------------------------------------------------------------------
 int MnxAnalyser::name_to_enum(const string& name) const
 {
-	map<string, int>::const_iterator it = m_NameToEnum.find(name);
+	auto it = m_NameToEnum.find(name);
 	if (it != m_NameToEnum.end())
 		return it->second;
     else
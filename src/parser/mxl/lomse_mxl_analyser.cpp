@@ -9301,6 +9301,7 @@ void MxlAnalyser::delete_relation_builders()
 ImoObj* MxlAnalyser::analyse_tree_and_get_object(XmlNode* root)
 {
     delete_relation_builders();
+    m_analysers.reset();
     m_pTiesBuilder = LOMSE_NEW MxlTiesBuilder(m_reporter, this);
     m_pBeamsBuilder = LOMSE_NEW MxlBeamsBuilder(m_reporter, this);
     m_pTupletsBuilder = LOMSE_NEW MxlTupletsBuilder(m_reporter, this);
@@ -9329,7 +9330,7 @@ ImoObj* MxlAnalyser::analyse_node(XmlNode* pNode, ImoObj* pAnchor)
     //m_reporter << "DBG. Analysing node: " << pNode->name() << endl;
     MxlElementAnalyser* a = new_analyser( pNode->name(), pAnchor );
     ImoObj* pImo = a->analyse_node(pNode);
-    delete a;
+    delete_analyser(a);
     return pImo;
 }
 
@@ -9338,7 +9339,7 @@ bool MxlAnalyser::analyse_node_bool(XmlNode* pNode, ImoObj* pAnchor)
 {
     MxlElementAnalyser* a = new_analyser( pNode->name(), pAnchor );
     bool value = a->analyse_node_bool(pNode);
-    delete a;
+    delete_analyser(a);
     return value;
 }
 
@@ -10153,93 +10154,100 @@ bool MxlAnalyser::to_integer(const string& text, int* pResult)
 //---------------------------------------------------------------------------------------
 MxlElementAnalyser* MxlAnalyser::new_analyser(const string& name, ImoObj* pAnchor)
 {
-    //Factory method to create analysers
+    //Factory method to create analysers. Created analysers must be deleted
+    //by invoking delete_analyser()
 
     switch ( name_to_enum(name) )
     {
-//        case k_mxl_tag_accordion_registration: return LOMSE_NEW AccordionRegistrationMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_arpeggiate:           return LOMSE_NEW ArpeggiateMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_articulations:        return LOMSE_NEW ArticulationsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_attributes:           return LOMSE_NEW AtribbutesMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_backup:               return LOMSE_NEW FwdBackMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_barline:              return LOMSE_NEW BarlineMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_bracket:              return LOMSE_NEW BracketMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_clef:                 return LOMSE_NEW ClefMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_coda:                 return LOMSE_NEW CodaMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_damp:                 return LOMSE_NEW DampMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_damp_all:             return LOMSE_NEW DampAllMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_dashes:               return LOMSE_NEW DashesMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_defaults:             return LOMSE_NEW DefaultsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_direction:            return LOMSE_NEW DirectionMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_direction_type:       return LOMSE_NEW DirectionTypeMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_dynamics:             return LOMSE_NEW DynamicsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_ending:               return LOMSE_NEW EndingMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_eyeglasses:           return LOMSE_NEW EyeglassesMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_fermata:              return LOMSE_NEW FermataMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_fingering:            return LOMSE_NEW FingeringMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_forward:              return LOMSE_NEW FwdBackMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_fret:                 return LOMSE_NEW FretStringMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_harp_pedals:          return LOMSE_NEW HarpPedalsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_image:                return LOMSE_NEW ImageMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_key:                  return LOMSE_NEW KeyMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_lyric:                return LOMSE_NEW LyricMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_measure:              return LOMSE_NEW MeasureMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_metronome:            return LOMSE_NEW MetronomeMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_midi_device:          return LOMSE_NEW MidiDeviceMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_midi_instrument:      return LOMSE_NEW MidiInstrumentMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_notations:            return LOMSE_NEW NotationsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_note:                 return LOMSE_NEW NoteRestMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_octave_shift:         return LOMSE_NEW OctaveShiftMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_ornaments:            return LOMSE_NEW OrnamentsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_page_layout:          return LOMSE_NEW PageLayoutMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_page_margins:         return LOMSE_NEW PageMarginsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_part:                 return LOMSE_NEW PartMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_part_group:           return LOMSE_NEW PartGroupMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_part_list:            return LOMSE_NEW PartListMxlAnalyser(this, m_reporter, m_libraryScope);
-        case k_mxl_tag_part_name:            return LOMSE_NEW PartNameMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_pedal:                return LOMSE_NEW PedalMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_percussion:           return LOMSE_NEW PercussionMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_pitch:                return LOMSE_NEW PitchMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_principal_voice:      return LOMSE_NEW PrincipalVoiceMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_print:                return LOMSE_NEW PrintMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_rehearsal:            return LOMSE_NEW RehearsalMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_rest:                 return LOMSE_NEW RestMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_scaling:              return LOMSE_NEW ScalingMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_scordatura:           return LOMSE_NEW ScordaturaMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_score_instrument:     return LOMSE_NEW ScoreInstrumentMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_score_part:           return LOMSE_NEW ScorePartMxlAnalyser(this, m_reporter, m_libraryScope);
-        case k_mxl_tag_score_partwise:       return LOMSE_NEW ScorePartwiseMxlAnalyser(this, m_reporter, m_libraryScope);
-        case k_mxl_tag_segno:                return LOMSE_NEW SegnoMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_slur:                 return LOMSE_NEW SlurMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_sound:                return LOMSE_NEW SoundMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-//        case k_mxl_tag_string_mute:          return LOMSE_NEW StringMuteMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_staff_details:        return LOMSE_NEW StaffDetailsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_staff_layout:         return LOMSE_NEW StaffLayoutMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_string:               return LOMSE_NEW FretStringMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_system_layout:        return LOMSE_NEW SystemLayoutMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_system_margins:       return LOMSE_NEW SystemMarginsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_technical:            return LOMSE_NEW TecnicalMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_text:                 return LOMSE_NEW TextMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_tied:                 return LOMSE_NEW TiedMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_time:                 return LOMSE_NEW TimeMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_time_modification:    return LOMSE_NEW TimeModificationXmlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_transpose:            return LOMSE_NEW TransposeMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_tuplet:               return LOMSE_NEW TupletMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_tuplet_actual:        return LOMSE_NEW TupletNumbersMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_tuplet_normal:        return LOMSE_NEW TupletNumbersMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_unpitched:            return LOMSE_NEW UnpitchedMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_virtual_instr:        return LOMSE_NEW VirtualInstrumentMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_wedge:                return LOMSE_NEW WedgeMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
-        case k_mxl_tag_words:                return LOMSE_NEW WordsMxlAnalyser(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_accordion_registration: return m_analysers.create<AccordionRegistrationMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_arpeggiate:           return m_analysers.create<ArpeggiateMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_articulations:        return m_analysers.create<ArticulationsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_attributes:           return m_analysers.create<AtribbutesMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_backup:               return m_analysers.create<FwdBackMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_barline:              return m_analysers.create<BarlineMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_bracket:              return m_analysers.create<BracketMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_clef:                 return m_analysers.create<ClefMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_coda:                 return m_analysers.create<CodaMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_damp:                 return m_analysers.create<DampMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_damp_all:             return m_analysers.create<DampAllMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_dashes:               return m_analysers.create<DashesMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_defaults:             return m_analysers.create<DefaultsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_direction:            return m_analysers.create<DirectionMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_direction_type:       return m_analysers.create<DirectionTypeMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_dynamics:             return m_analysers.create<DynamicsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_ending:               return m_analysers.create<EndingMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_eyeglasses:           return m_analysers.create<EyeglassesMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_fermata:              return m_analysers.create<FermataMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_fingering:            return m_analysers.create<FingeringMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_forward:              return m_analysers.create<FwdBackMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_fret:                 return m_analysers.create<FretStringMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_harp_pedals:          return m_analysers.create<HarpPedalsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_image:                return m_analysers.create<ImageMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_key:                  return m_analysers.create<KeyMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_lyric:                return m_analysers.create<LyricMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_measure:              return m_analysers.create<MeasureMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_metronome:            return m_analysers.create<MetronomeMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_midi_device:          return m_analysers.create<MidiDeviceMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_midi_instrument:      return m_analysers.create<MidiInstrumentMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_notations:            return m_analysers.create<NotationsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_note:                 return m_analysers.create<NoteRestMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_octave_shift:         return m_analysers.create<OctaveShiftMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_ornaments:            return m_analysers.create<OrnamentsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_page_layout:          return m_analysers.create<PageLayoutMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_page_margins:         return m_analysers.create<PageMarginsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_part:                 return m_analysers.create<PartMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_part_group:           return m_analysers.create<PartGroupMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_part_list:            return m_analysers.create<PartListMxlAnalyser>(this, m_reporter, m_libraryScope);
+        case k_mxl_tag_part_name:            return m_analysers.create<PartNameMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_pedal:                return m_analysers.create<PedalMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_percussion:           return m_analysers.create<PercussionMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_pitch:                return m_analysers.create<PitchMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_principal_voice:      return m_analysers.create<PrincipalVoiceMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_print:                return m_analysers.create<PrintMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_rehearsal:            return m_analysers.create<RehearsalMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_rest:                 return m_analysers.create<RestMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_scaling:              return m_analysers.create<ScalingMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_scordatura:           return m_analysers.create<ScordaturaMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_score_instrument:     return m_analysers.create<ScoreInstrumentMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_score_part:           return m_analysers.create<ScorePartMxlAnalyser>(this, m_reporter, m_libraryScope);
+        case k_mxl_tag_score_partwise:       return m_analysers.create<ScorePartwiseMxlAnalyser>(this, m_reporter, m_libraryScope);
+        case k_mxl_tag_segno:                return m_analysers.create<SegnoMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_slur:                 return m_analysers.create<SlurMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_sound:                return m_analysers.create<SoundMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+//        case k_mxl_tag_string_mute:          return m_analysers.create<StringMuteMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_staff_details:        return m_analysers.create<StaffDetailsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_staff_layout:         return m_analysers.create<StaffLayoutMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_string:               return m_analysers.create<FretStringMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_system_layout:        return m_analysers.create<SystemLayoutMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_system_margins:       return m_analysers.create<SystemMarginsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_technical:            return m_analysers.create<TecnicalMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_text:                 return m_analysers.create<TextMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_tied:                 return m_analysers.create<TiedMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_time:                 return m_analysers.create<TimeMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_time_modification:    return m_analysers.create<TimeModificationXmlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_transpose:            return m_analysers.create<TransposeMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_tuplet:               return m_analysers.create<TupletMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_tuplet_actual:        return m_analysers.create<TupletNumbersMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_tuplet_normal:        return m_analysers.create<TupletNumbersMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_unpitched:            return m_analysers.create<UnpitchedMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_virtual_instr:        return m_analysers.create<VirtualInstrumentMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_wedge:                return m_analysers.create<WedgeMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
+        case k_mxl_tag_words:                return m_analysers.create<WordsMxlAnalyser>(this, m_reporter, m_libraryScope, pAnchor);
         default:
-            return LOMSE_NEW NullMxlAnalyser(this, m_reporter, m_libraryScope, name);
+            return m_analysers.create<NullMxlAnalyser>(this, m_reporter, m_libraryScope, name);
     }
 }
 
+//---------------------------------------------------------------------------------------
+void MxlAnalyser::delete_analyser(MxlElementAnalyser* a)
+{
+    m_analysers.release(a);
+}
+
 //---------------------------------------------------------------------------------------
 int MxlAnalyser::name_to_enum(const string& name) const
 {
-	map<string, int>::const_iterator it = m_NameToEnum.find(name);
+	auto it = m_NameToEnum.find(name);
 	if (it != m_NameToEnum.end())
 		return it->second;
     else
@@ -36,6 +36,8 @@ std::string FontSelector::find_font(const std::string& language,
                                     const std::string& name,
                                     bool fBold, bool fItalic)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     //Priority is given to font file.
     //For generic families (i.e.: sans, serif, monospace, ...) priority is given to
     //language
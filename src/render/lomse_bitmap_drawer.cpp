@@ -27,6 +27,9 @@
 
 #include "agg_path_storage.h"
 
+#include <cstdlib>      //abs
+#include <cstring>      //memmove
+
 
 
 using namespace std;
@@ -246,6 +249,17 @@ void Drawer::set_text_color(Color color)
     m_textColor = color;
 }
 
+//---------------------------------------------------------------------------------------
+void Drawer::filled_rectangle(LUnits left, LUnits top, LUnits right, LUnits bottom,
+                              Color color)
+{
+    begin_path();
+    fill(color);
+    stroke_none();
+    rect(UPoint(left, top), USize(right - left, bottom - top), 0.0f);
+    end_path();
+}
+
 //---------------------------------------------------------------------------------------
 void Drawer::new_viewport_origin(double x, double y)
 {
@@ -634,6 +648,17 @@ void BitmapDrawer::reset(Color bgcolor)
 {
     m_pRenderer->initialize(m_rbuf, bgcolor);
     delete_paths();
+    use_font_storage_for_this_thread();
+}
+
+//---------------------------------------------------------------------------------------
+void BitmapDrawer::use_font_storage_for_this_thread()
+{
+    //Each thread has its own font engine. Rendering could take place in a thread
+    //different from the one that created this drawer
+
+    m_pFonts = m_libraryScope.font_storage();
+    m_pCalligrapher->set_font_storage(m_pFonts);
 }
 
 //---------------------------------------------------------------------------------------
@@ -678,6 +703,59 @@ void BitmapDrawer::set_view_area(unsigned width, unsigned height, unsigned xShif
     m_rbuf.attach(start, width, height, stride);
 }
 
+//---------------------------------------------------------------------------------------
+bool BitmapDrawer::is_view_area_full_buffer() const
+{
+    return m_pBuf != nullptr && m_rbuf.buf() == m_pBuf
+           && m_rbuf.width() == m_bufWidth && m_rbuf.height() == m_bufHeight;
+}
+
+//---------------------------------------------------------------------------------------
+void BitmapDrawer::scroll_view_area(int dx, int dy)
+{
+    //move view area content dx, dy pixels. Uncovered pixels are not modified
+
+    int width = int(m_rbuf.width());
+    int height = int(m_rbuf.height());
+    if (abs(dx) >= width || abs(dy) >= height)
+        return;
+
+    int bytesPerPixel = Renderer::bytesPerPixel( m_libraryScope.get_pixel_format() );
+    size_t bytes = size_t(width - abs(dx)) * size_t(bytesPerPixel);
+    int xSrc = (dx < 0 ? -dx : 0) * bytesPerPixel;
+    int xDest = (dx > 0 ? dx : 0) * bytesPerPixel;
+
+    //when moving down, rows must be copied from bottom to top
+    if (dy > 0)
+    {
+        for (int y = height - 1; y >= dy; --y)
+            memmove(m_rbuf.row_ptr(y) + xDest, m_rbuf.row_ptr(y - dy) + xSrc, bytes);
+    }
+    else
+    {
+        for (int y = 0; y < height + dy; ++y)
+            memmove(m_rbuf.row_ptr(y) + xDest, m_rbuf.row_ptr(y - dy) + xSrc, bytes);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void BitmapDrawer::begin_partial_render(Pixels x1, Pixels y1, Pixels x2, Pixels y2,
+                                        Color bgcolor)
+{
+    //restrict drawing to rectangle (x1, y1) - (x2, y2), excluding right and bottom
+    //edges, and clear it with the background color
+    m_pRenderer->set_clip_box(x1, y1, x2 - 1, y2 - 1);
+    m_pRenderer->clear_clip_box(bgcolor);
+    delete_paths();
+    use_font_storage_for_this_thread();
+}
+
+//---------------------------------------------------------------------------------------
+void BitmapDrawer::end_partial_render()
+{
+    m_pRenderer->reset_clip_box();
+}
+
 //---------------------------------------------------------------------------------------
 void BitmapDrawer::new_viewport_origin(double x, double y)
 {
@@ -707,6 +785,16 @@ void BitmapDrawer::render()
     delete_paths();
 }
 
+//---------------------------------------------------------------------------------------
+void BitmapDrawer::filled_rectangle(LUnits left, LUnits top, LUnits right,
+                                    LUnits bottom, Color color)
+{
+    //the rectangle is directly blended into the buffer, without using the rasterizer.
+    //Previous paths must be rendered before, to preserve the drawing order
+    render_existing_paths();
+    m_pRenderer->render_rectangle(left, top, right, bottom, color);
+}
+
 //---------------------------------------------------------------------------------------
 void BitmapDrawer::set_shift(LUnits x, LUnits y)
 {
@@ -0,0 +1,960 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include "lomse_display_list.h"
+
+#include "lomse_vertex_source.h"
+
+//std
+#include <cstdlib>      //abs
+#include <cstring>      //memcpy
+
+namespace lomse
+{
+
+//=======================================================================================
+// Helper class RecordedPath: a vertex source for replaying a recorded path
+//=======================================================================================
+class RecordedPath : public VertexSource
+{
+protected:
+    const double* m_pData;      //triplets (cmd, x, y)
+    size_t m_numVertices;
+    size_t m_i;
+
+public:
+    RecordedPath(const double* pData, size_t numVertices)
+        : VertexSource()
+        , m_pData(pData)
+        , m_numVertices(numVertices)
+        , m_i(0)
+    {
+    }
+
+    void rewind(unsigned) override { m_i = 0; }
+    unsigned vertex(double* x, double* y) override
+    {
+        if (m_i >= m_numVertices)
+            return agg::path_cmd_stop;
+
+        const double* v = m_pData + 3 * m_i++;
+        *x = v[1];
+        *y = v[2];
+        return unsigned(v[0]);
+    }
+};
+
+//---------------------------------------------------------------------------------------
+static bool is_same_color(Color c1, Color c2)
+{
+    return c1.r == c2.r && c1.g == c2.g && c1.b == c2.b && c1.a == c2.a;
+}
+
+//---------------------------------------------------------------------------------------
+//Only the options used by the graphic objects when drawing are compared. Scale,
+//culling and options for the view (e.g. page border) do not affect the commands.
+static bool is_same_appearance(const RenderOptions& opt1, const RenderOptions& opt2)
+{
+    if (opt1.boxes != opt2.boxes
+        || opt1.draw_anchor_objects != opt2.draw_anchor_objects
+        || opt1.draw_anchor_lines != opt2.draw_anchor_lines
+        || opt1.draw_shape_bounds != opt2.draw_shape_bounds
+        || opt1.draw_slur_points != opt2.draw_slur_points
+        || opt1.draw_vertical_profile != opt2.draw_vertical_profile
+        || opt1.draw_chords_coloured != opt2.draw_chords_coloured
+        || opt1.draw_focus_lines_on_boxes_flag != opt2.draw_focus_lines_on_boxes_flag
+        || opt1.draw_shapes_highlighted != opt2.draw_shapes_highlighted
+        || opt1.draw_shapes_dragged != opt2.draw_shapes_dragged
+        || opt1.draw_shapes_selected != opt2.draw_shapes_selected
+        || opt1.draw_voices_coloured != opt2.draw_voices_coloured
+        || opt1.read_only_mode != opt2.read_only_mode
+        || opt1.highlighted_voice != opt2.highlighted_voice)
+    {
+        return false;
+    }
+
+    if (!is_same_color(opt1.highlighted_color, opt2.highlighted_color)
+        || !is_same_color(opt1.dragged_color, opt2.dragged_color)
+        || !is_same_color(opt1.selected_color, opt2.selected_color)
+        || !is_same_color(opt1.focussed_box_color, opt2.focussed_box_color)
+        || !is_same_color(opt1.unfocussed_box_color, opt2.unfocussed_box_color)
+        || !is_same_color(opt1.not_highlighted_voice_color,
+                          opt2.not_highlighted_voice_color))
+    {
+        return false;
+    }
+
+    for (int i=0; i < 9; ++i)
+    {
+        if (!is_same_color(opt1.voiceColor[i], opt2.voiceColor[i]))
+            return false;
+    }
+    return true;
+}
+
+
+//=======================================================================================
+// DisplayList implementation
+//=======================================================================================
+DisplayList::DisplayList(Drawer* pDrawer, const RenderOptions& opt)
+    : m_options(opt)
+    , m_fFilledRectangles(pDrawer->accepts_filled_rectangles())
+    , m_fIdClass(pDrawer->accepts_id_class())
+{
+    //commands received before the first object are always replayed
+    DisplayObject obj = { URect(), true, 0, 0 };
+    m_objects.push_back(obj);
+}
+
+//---------------------------------------------------------------------------------------
+bool DisplayList::is_valid_for(Drawer* pDrawer, const RenderOptions& opt) const
+{
+    return pDrawer->accepts_filled_rectangles() == m_fFilledRectangles
+           && pDrawer->accepts_id_class() == m_fIdClass
+           && is_same_appearance(m_options, opt);
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::start_object(const URect& bounds)
+{
+    //an object without commands is replaced by the new one
+    if (m_objects.back().iCommand == m_commands.size())
+        m_objects.pop_back();
+
+    DisplayObject obj = { bounds, false, m_commands.size(), m_values.size() };
+    m_objects.push_back(obj);
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::add_color(Color color)
+{
+    //the four channels are packed in an integer value, exactly representable
+    unsigned value = unsigned(color.r) | (unsigned(color.g) << 8)
+                     | (unsigned(color.b) << 16) | (unsigned(color.a) << 24);
+    m_values.push_back(double(value));
+}
+
+//---------------------------------------------------------------------------------------
+Color DisplayList::to_color(double value)
+{
+    unsigned c = unsigned(value);
+    return Color(c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, (c >> 24) & 0xFF);
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::add_string(const std::string& str)
+{
+    m_values.push_back(double(m_strings.size()));
+    m_strings.push_back(str);
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::add_wstring(const std::wstring& str)
+{
+    m_values.push_back(double(m_wstrings.size()));
+    m_wstrings.push_back(str);
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::add_bitmap(RenderingBuffer& bmap)
+{
+    m_values.push_back(double(m_bitmaps.size()));
+    m_bitmaps.push_back(DisplayBitmap());
+
+    //copy the rows. The copy is always top-down
+    DisplayBitmap& bitmap = m_bitmaps.back();
+    bitmap.width = bmap.width();
+    bitmap.height = bmap.height();
+    bitmap.stride = std::abs(bmap.stride());
+    bitmap.pixels.resize(size_t(bitmap.stride) * bitmap.height);
+    for (unsigned y=0; y < bitmap.height; ++y)
+        memcpy(&bitmap.pixels[size_t(y) * bitmap.stride], bmap.row_ptr(int(y)),
+               size_t(bitmap.stride));
+}
+
+//---------------------------------------------------------------------------------------
+size_t DisplayList::memory_used() const
+{
+    size_t bytes = m_commands.capacity()
+                   + m_values.capacity() * sizeof(double)
+                   + m_objects.capacity() * sizeof(DisplayObject)
+                   + m_bitmaps.capacity() * sizeof(DisplayBitmap);
+    for (const DisplayBitmap& bitmap : m_bitmaps)
+        bytes += bitmap.pixels.capacity();
+    for (const std::string& str : m_strings)
+        bytes += sizeof(std::string) + str.capacity();
+    for (const std::wstring& str : m_wstrings)
+        bytes += sizeof(std::wstring) + str.capacity() * sizeof(wchar_t);
+    return bytes;
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::replay(Drawer* pDrawer, RenderOptions& opt) const
+{
+    size_t numObjects = m_objects.size();
+    for (size_t i=0; i < numObjects; ++i)
+    {
+        const DisplayObject& obj = m_objects[i];
+        if (obj.fAlwaysVisible || opt.is_visible(obj.bounds))
+        {
+            size_t iEnd = (i + 1 < numObjects ? m_objects[i+1].iCommand
+                                              : m_commands.size());
+            replay_commands(pDrawer, obj.iCommand, iEnd, obj.iValue);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void DisplayList::replay_commands(Drawer* pDrawer, size_t iCmd, size_t iEnd,
+                                  size_t iValue) const
+{
+    const double* v = m_values.data() + iValue;
+
+    for (; iCmd < iEnd; ++iCmd)
+    {
+        switch (m_commands[iCmd])
+        {
+            case k_begin_path:
+                pDrawer->begin_path();
+                break;
+
+            case k_end_path:
+                pDrawer->end_path();
+                break;
+
+            case k_close_path:
+                pDrawer->close_path();
+                break;
+
+            case k_add_path:
+            {
+                bool fSolid = (v[0] != 0.0);
+                size_t numVertices = size_t(v[1]);
+                RecordedPath path(v + 2, numVertices);
+                pDrawer->add_path(path, 0, fSolid);
+                v += 2 + 3 * numVertices;
+                break;
+            }
+
+            case k_move_to:
+                pDrawer->move_to(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_move_to_rel:
+                pDrawer->move_to_rel(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_line_to:
+                pDrawer->line_to(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_line_to_rel:
+                pDrawer->line_to_rel(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_hline_to:
+                pDrawer->hline_to(v[0]);
+                v += 1;
+                break;
+
+            case k_hline_to_rel:
+                pDrawer->hline_to_rel(v[0]);
+                v += 1;
+                break;
+
+            case k_vline_to:
+                pDrawer->vline_to(v[0]);
+                v += 1;
+                break;
+
+            case k_vline_to_rel:
+                pDrawer->vline_to_rel(v[0]);
+                v += 1;
+                break;
+
+            case k_quadratic_bezier:
+                pDrawer->quadratic_bezier(v[0], v[1], v[2], v[3]);
+                v += 4;
+                break;
+
+            case k_quadratic_bezier_rel:
+                pDrawer->quadratic_bezier_rel(v[0], v[1], v[2], v[3]);
+                v += 4;
+                break;
+
+            case k_smooth_quadratic_bezier:
+                pDrawer->quadratic_bezier(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_smooth_quadratic_bezier_rel:
+                pDrawer->quadratic_bezier_rel(v[0], v[1]);
+                v += 2;
+                break;
+
+            case k_cubic_bezier:
+                pDrawer->cubic_bezier(v[0], v[1], v[2], v[3], v[4], v[5]);
+                v += 6;
+                break;
+
+            case k_cubic_bezier_rel:
+                pDrawer->cubic_bezier_rel(v[0], v[1], v[2], v[3], v[4], v[5]);
+                v += 6;
+                break;
+
+            case k_smooth_cubic_bezier:
+                pDrawer->cubic_bezier(v[0], v[1], v[2], v[3]);
+                v += 4;
+                break;
+
+            case k_smooth_cubic_bezier_rel:
+                pDrawer->cubic_bezier_rel(v[0], v[1], v[2], v[3]);
+                v += 4;
+                break;
+
+            case k_rect:
+                pDrawer->rect(UPoint(LUnits(v[0]), LUnits(v[1])),
+                              USize(LUnits(v[2]), LUnits(v[3])), LUnits(v[4]));
+                v += 5;
+                break;
+
+            case k_circle:
+                pDrawer->circle(LUnits(v[0]), LUnits(v[1]), LUnits(v[2]));
+                v += 3;
+                break;
+
+            case k_line:
+                pDrawer->line(LUnits(v[0]), LUnits(v[1]), LUnits(v[2]), LUnits(v[3]),
+                              LUnits(v[4]), ELineEdge(int(v[5])));
+                v += 6;
+                break;
+
+            case k_polygon:
+            {
+                int n = int(v[0]);
+                std::vector<UPoint> points(n);
+                for (int i=0; i < n; ++i)
+                    points[i] = UPoint(LUnits(v[1 + 2*i]), LUnits(v[2 + 2*i]));
+                pDrawer->polygon(n, points.data());
+                v += 1 + 2 * n;
+                break;
+            }
+
+            case k_line_with_markers:
+                pDrawer->line_with_markers(UPoint(LUnits(v[0]), LUnits(v[1])),
+                                           UPoint(LUnits(v[2]), LUnits(v[3])),
+                                           LUnits(v[4]), ELineCap(int(v[5])),
+                                           ELineCap(int(v[6])));
+                v += 7;
+                break;
+
+            case k_filled_rectangle:
+                pDrawer->filled_rectangle(LUnits(v[0]), LUnits(v[1]), LUnits(v[2]),
+                                          LUnits(v[3]), to_color(v[4]));
+                v += 5;
+                break;
+
+            case k_fill:
+                pDrawer->fill(to_color(v[0]));
+                v += 1;
+                break;
+
+            case k_fill_none:
+                pDrawer->fill_none();
+                break;
+
+            case k_stroke:
+                pDrawer->stroke(to_color(v[0]));
+                v += 1;
+                break;
+
+            case k_stroke_none:
+                pDrawer->stroke_none();
+                break;
+
+            case k_stroke_width:
+                pDrawer->stroke_width(v[0]);
+                v += 1;
+                break;
+
+            case k_gradient_color:
+                pDrawer->gradient_color(to_color(v[0]), to_color(v[1]), v[2], v[3]);
+                v += 4;
+                break;
+
+            case k_gradient_start_color:
+                pDrawer->gradient_color(to_color(v[0]), v[1], v[2]);
+                v += 3;
+                break;
+
+            case k_fill_linear_gradient:
+                pDrawer->fill_linear_gradient(LUnits(v[0]), LUnits(v[1]), LUnits(v[2]),
+                                              LUnits(v[3]));
+                v += 4;
+                break;
+
+            case k_select_font:
+                pDrawer->select_font(m_strings[size_t(v[0])], m_strings[size_t(v[1])],
+                                     m_strings[size_t(v[2])], v[3], v[4] != 0.0,
+                                     v[5] != 0.0);
+                v += 6;
+                break;
+
+            case k_set_text_color:
+                pDrawer->set_text_color(to_color(v[0]));
+                v += 1;
+                break;
+
+            case k_draw_text:
+                pDrawer->draw_text(v[0], v[1], m_strings[size_t(v[2])]);
+                v += 3;
+                break;
+
+            case k_draw_wtext:
+                pDrawer->draw_text(v[0], v[1], m_wstrings[size_t(v[2])]);
+                v += 3;
+                break;
+
+            case k_draw_glyph:
+                pDrawer->draw_glyph(v[0], v[1], (unsigned int)(v[2]));
+                v += 3;
+                break;
+
+            case k_draw_glyph_rotated:
+                pDrawer->draw_glyph_rotated(v[0], v[1], (unsigned int)(v[2]), v[3]);
+                v += 4;
+                break;
+
+            case k_draw_bitmap:
+            {
+                const DisplayBitmap& bitmap = m_bitmaps[size_t(v[0])];
+                RenderingBuffer rbuf;
+                rbuf.attach(const_cast<unsigned char*>(bitmap.pixels.data()),
+                            bitmap.width, bitmap.height, bitmap.stride);
+                pDrawer->draw_bitmap(rbuf, v[1] != 0.0,
+                                     Pixels(v[2]), Pixels(v[3]), Pixels(v[4]),
+                                     Pixels(v[5]),
+                                     LUnits(v[6]), LUnits(v[7]), LUnits(v[8]),
+                                     LUnits(v[9]),
+                                     EResamplingQuality(int(v[10])), v[11]);
+                v += 12;
+                break;
+            }
+
+            case k_render:
+                pDrawer->render();
+                break;
+
+            case k_start_simple_notation:
+                pDrawer->start_simple_notation(m_strings[size_t(v[0])],
+                                               m_strings[size_t(v[1])]);
+                v += 2;
+                break;
+
+            case k_start_composite_notation:
+                pDrawer->start_composite_notation(m_strings[size_t(v[0])],
+                                                  m_strings[size_t(v[1])]);
+                v += 2;
+                break;
+
+            case k_end_composite_notation:
+                pDrawer->end_composite_notation();
+                break;
+        }
+    }
+}
+
+
+//=======================================================================================
+// RecordingDrawer implementation
+//=======================================================================================
+RecordingDrawer::RecordingDrawer(Drawer* pTarget, DisplayList* pList)
+    : Drawer(pTarget->get_library_scope())
+    , m_pTarget(pTarget)
+    , m_pList(pList)
+{
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::begin_path()
+{
+    m_pList->add_command(DisplayList::k_begin_path);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::end_path()
+{
+    m_pList->add_command(DisplayList::k_end_path);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::close_path()
+{
+    m_pList->add_command(DisplayList::k_close_path);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::add_path(VertexSource& vs, unsigned path_id, bool solid_path)
+{
+    //the vertices are copied, as the vertex source could not exist when replaying
+    m_pList->add_command(DisplayList::k_add_path);
+    m_pList->add_value(solid_path ? 1.0 : 0.0);
+
+    std::vector<double> vertices;
+    double x, y;
+    unsigned cmd;
+    vs.rewind(path_id);
+    while (!agg::is_stop(cmd = vs.vertex(&x, &y)))
+    {
+        vertices.push_back(double(cmd));
+        vertices.push_back(x);
+        vertices.push_back(y);
+    }
+
+    m_pList->add_value(double(vertices.size() / 3));
+    for (double value : vertices)
+        m_pList->add_value(value);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::move_to(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_move_to);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::move_to_rel(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_move_to_rel);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::line_to(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_line_to);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::line_to_rel(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_line_to_rel);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::hline_to(double x)
+{
+    m_pList->add_command(DisplayList::k_hline_to);
+    m_pList->add_value(x);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::hline_to_rel(double x)
+{
+    m_pList->add_command(DisplayList::k_hline_to_rel);
+    m_pList->add_value(x);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::vline_to(double y)
+{
+    m_pList->add_command(DisplayList::k_vline_to);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::vline_to_rel(double y)
+{
+    m_pList->add_command(DisplayList::k_vline_to_rel);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::quadratic_bezier(double x1, double y1, double x, double y)
+{
+    m_pList->add_command(DisplayList::k_quadratic_bezier);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::quadratic_bezier_rel(double x1, double y1, double x, double y)
+{
+    m_pList->add_command(DisplayList::k_quadratic_bezier_rel);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::quadratic_bezier(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_smooth_quadratic_bezier);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::quadratic_bezier_rel(double x, double y)
+{
+    m_pList->add_command(DisplayList::k_smooth_quadratic_bezier_rel);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::cubic_bezier(double x1, double y1, double x2, double y2,
+                                   double x, double y)
+{
+    m_pList->add_command(DisplayList::k_cubic_bezier);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::cubic_bezier_rel(double x1, double y1, double x2, double y2,
+                                       double x, double y)
+{
+    m_pList->add_command(DisplayList::k_cubic_bezier_rel);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::cubic_bezier(double x2, double y2, double x, double y)
+{
+    m_pList->add_command(DisplayList::k_smooth_cubic_bezier);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::cubic_bezier_rel(double x2, double y2, double x, double y)
+{
+    m_pList->add_command(DisplayList::k_smooth_cubic_bezier_rel);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::rect(UPoint pos, USize size, LUnits radius)
+{
+    m_pList->add_command(DisplayList::k_rect);
+    m_pList->add_value(pos.x);
+    m_pList->add_value(pos.y);
+    m_pList->add_value(size.width);
+    m_pList->add_value(size.height);
+    m_pList->add_value(radius);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::circle(LUnits xCenter, LUnits yCenter, LUnits radius)
+{
+    m_pList->add_command(DisplayList::k_circle);
+    m_pList->add_value(xCenter);
+    m_pList->add_value(yCenter);
+    m_pList->add_value(radius);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::line(LUnits x1, LUnits y1, LUnits x2, LUnits y2,
+                           LUnits width, ELineEdge nEdge)
+{
+    m_pList->add_command(DisplayList::k_line);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+    m_pList->add_value(width);
+    m_pList->add_value(double(nEdge));
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::polygon(int n, UPoint points[])
+{
+    m_pList->add_command(DisplayList::k_polygon);
+    m_pList->add_value(double(n));
+    for (int i=0; i < n; ++i)
+    {
+        m_pList->add_value(points[i].x);
+        m_pList->add_value(points[i].y);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::line_with_markers(UPoint start, UPoint end, LUnits width,
+                                        ELineCap startCap, ELineCap endCap)
+{
+    m_pList->add_command(DisplayList::k_line_with_markers);
+    m_pList->add_value(start.x);
+    m_pList->add_value(start.y);
+    m_pList->add_value(end.x);
+    m_pList->add_value(end.y);
+    m_pList->add_value(width);
+    m_pList->add_value(double(startCap));
+    m_pList->add_value(double(endCap));
+}
+
+//---------------------------------------------------------------------------------------
+bool RecordingDrawer::accepts_filled_rectangles() const
+{
+    return m_pTarget->accepts_filled_rectangles();
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::filled_rectangle(LUnits left, LUnits top, LUnits right,
+                                       LUnits bottom, Color color)
+{
+    m_pList->add_command(DisplayList::k_filled_rectangle);
+    m_pList->add_value(left);
+    m_pList->add_value(top);
+    m_pList->add_value(right);
+    m_pList->add_value(bottom);
+    m_pList->add_color(color);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::fill(Color color)
+{
+    m_pList->add_command(DisplayList::k_fill);
+    m_pList->add_color(color);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::fill_none()
+{
+    m_pList->add_command(DisplayList::k_fill_none);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::stroke(Color color)
+{
+    m_pList->add_command(DisplayList::k_stroke);
+    m_pList->add_color(color);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::stroke_none()
+{
+    m_pList->add_command(DisplayList::k_stroke_none);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::stroke_width(double w)
+{
+    m_pList->add_command(DisplayList::k_stroke_width);
+    m_pList->add_value(w);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::gradient_color(Color c1, Color c2, double start, double stop)
+{
+    m_pList->add_command(DisplayList::k_gradient_color);
+    m_pList->add_color(c1);
+    m_pList->add_color(c2);
+    m_pList->add_value(start);
+    m_pList->add_value(stop);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::gradient_color(Color c1, double start, double stop)
+{
+    m_pList->add_command(DisplayList::k_gradient_start_color);
+    m_pList->add_color(c1);
+    m_pList->add_value(start);
+    m_pList->add_value(stop);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::fill_linear_gradient(LUnits x1, LUnits y1, LUnits x2, LUnits y2)
+{
+    m_pList->add_command(DisplayList::k_fill_linear_gradient);
+    m_pList->add_value(x1);
+    m_pList->add_value(y1);
+    m_pList->add_value(x2);
+    m_pList->add_value(y2);
+}
+
+//---------------------------------------------------------------------------------------
+bool RecordingDrawer::select_font(const std::string& language,
+                                  const std::string& fontFile,
+                                  const std::string& fontName, double height,
+                                  bool fBold, bool fItalic)
+{
+    m_pList->add_command(DisplayList::k_select_font);
+    m_pList->add_string(language);
+    m_pList->add_string(fontFile);
+    m_pList->add_string(fontName);
+    m_pList->add_value(height);
+    m_pList->add_value(fBold ? 1.0 : 0.0);
+    m_pList->add_value(fItalic ? 1.0 : 0.0);
+    return false;   //no error. Fonts are selected when replaying
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::set_text_color(Color color)
+{
+    Drawer::set_text_color(color);
+    m_pList->add_command(DisplayList::k_set_text_color);
+    m_pList->add_color(color);
+}
+
+//---------------------------------------------------------------------------------------
+int RecordingDrawer::draw_text(double x, double y, const std::string& str)
+{
+    m_pList->add_command(DisplayList::k_draw_text);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+    m_pList->add_string(str);
+    return int(str.size());
+}
+
+//---------------------------------------------------------------------------------------
+int RecordingDrawer::draw_text(double x, double y, const wstring& str)
+{
+    m_pList->add_command(DisplayList::k_draw_wtext);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+    m_pList->add_wstring(str);
+    return int(str.size());
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::draw_glyph(double x, double y, unsigned int ch)
+{
+    m_pList->add_command(DisplayList::k_draw_glyph);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+    m_pList->add_value(double(ch));
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::draw_glyph_rotated(double x, double y, unsigned int ch,
+                                         double rotation)
+{
+    m_pList->add_command(DisplayList::k_draw_glyph_rotated);
+    m_pList->add_value(x);
+    m_pList->add_value(y);
+    m_pList->add_value(double(ch));
+    m_pList->add_value(rotation);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::draw_bitmap(RenderingBuffer& bmap, bool hasAlpha,
+                                  Pixels srcX1, Pixels srcY1, Pixels srcX2, Pixels srcY2,
+                                  LUnits dstX1, LUnits dstY1, LUnits dstX2, LUnits dstY2,
+                                  EResamplingQuality resamplingMode, double alpha)
+{
+    m_pList->add_command(DisplayList::k_draw_bitmap);
+    m_pList->add_bitmap(bmap);
+    m_pList->add_value(hasAlpha ? 1.0 : 0.0);
+    m_pList->add_value(double(srcX1));
+    m_pList->add_value(double(srcY1));
+    m_pList->add_value(double(srcX2));
+    m_pList->add_value(double(srcY2));
+    m_pList->add_value(dstX1);
+    m_pList->add_value(dstY1);
+    m_pList->add_value(dstX2);
+    m_pList->add_value(dstY2);
+    m_pList->add_value(double(resamplingMode));
+    m_pList->add_value(alpha);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::render()
+{
+    m_pList->add_command(DisplayList::k_render);
+}
+
+//---------------------------------------------------------------------------------------
+bool RecordingDrawer::accepts_id_class() const
+{
+    return m_pTarget->accepts_id_class();
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::device_point_to_model(double* x, double* y) const
+{
+    m_pTarget->device_point_to_model(x, y);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::model_point_to_device(double* x, double* y) const
+{
+    m_pTarget->model_point_to_device(x, y);
+}
+
+//---------------------------------------------------------------------------------------
+LUnits RecordingDrawer::device_units_to_model(double value) const
+{
+    return m_pTarget->device_units_to_model(value);
+}
+
+//---------------------------------------------------------------------------------------
+double RecordingDrawer::model_to_device_units(LUnits value) const
+{
+    return m_pTarget->model_to_device_units(value);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::start_simple_notation(std::string id, std::string classname)
+{
+    m_pList->add_command(DisplayList::k_start_simple_notation);
+    m_pList->add_string(id);
+    m_pList->add_string(classname);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::start_composite_notation(std::string id, std::string classname)
+{
+    m_pList->add_command(DisplayList::k_start_composite_notation);
+    m_pList->add_string(id);
+    m_pList->add_string(classname);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::end_composite_notation()
+{
+    m_pList->add_command(DisplayList::k_end_composite_notation);
+}
+
+//---------------------------------------------------------------------------------------
+void RecordingDrawer::start_object(const URect& bounds)
+{
+    m_pList->start_object(bounds);
+}
+
+
+}   //namespace lomse
@@ -43,7 +43,12 @@ FontStorage::FontStorage(LibraryScope* pLibScope)
     , m_fKerning(true)
     , m_fFlip_y(true)
     , m_fontCacheType(k_raster_font_cache)
+    , m_numFontChanges(0)
 {
+    m_lastRequest.fBold = false;
+    m_lastRequest.fItalic = false;
+    m_lastRequest.fontPathsRevision = 0L;
+
     //AWARE:
     //Apple Computer, Inc., owns three patents that are related to the
     //hinting process of glyph outlines within TrueType fonts. Hinting (also named
@@ -76,7 +81,17 @@ FontStorage::~FontStorage()
 bool FontStorage::set_font(const std::string& fontFullName, double height,
                            EFontCacheType type)
 {
+    //Selecting the font and setting its size forces FreeType to re-select the face
+    //and to recompute the font signature. Nothing to do if the font is already
+    //selected, which is the usual case when drawing many glyphs of the music font
+    if (m_fValidFont && m_fontCacheType == type && m_fontHeight == height
+        && m_fontWidth == height && m_fontFullName == fontFullName)
+    {
+        return false;
+    }
+
     m_fValidFont = false;
+    ++m_numFontChanges;
     lomse::glyph_rendering gren = lomse::glyph_ren_agg_gray8;
     if(! m_fontEngine.select_font(fontFullName, 0, gren))
         return !m_fValidFont;    //error
@@ -120,6 +135,44 @@ void FontStorage::set_font_width(double rPoints)
     m_fontEngine.width(rPoints);
 }
 
+//---------------------------------------------------------------------------------------
+void FontStorage::set_transform(agg::trans_affine& mtx)
+{
+    //changing the transform recomputes the font signature, forcing the cache manager
+    //to search for the glyphs cache. Avoid it when the transform doesn't change
+    if (!mtx.is_equal(m_transform))
+    {
+        m_transform = mtx;
+        m_fontEngine.transform(mtx);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+const std::string& FontStorage::find_font_file(const std::string& language,
+                                               const std::string& fontFile,
+                                               const std::string& fontName,
+                                               bool fBold, bool fItalic)
+{
+    long revision = m_pLibScope->get_font_paths_revision();
+    if (m_lastRequest.fullFile.empty()
+        || m_lastRequest.fontPathsRevision != revision
+        || m_lastRequest.fBold != fBold || m_lastRequest.fItalic != fItalic
+        || m_lastRequest.fontName != fontName || m_lastRequest.fontFile != fontFile
+        || m_lastRequest.language != language)
+    {
+        FontSelector* fs = m_pLibScope->get_font_selector();
+        m_lastRequest.fullFile = fs->find_font(language, fontFile, fontName,
+                                               fBold, fItalic);
+        m_lastRequest.language = language;
+        m_lastRequest.fontFile = fontFile;
+        m_lastRequest.fontName = fontName;
+        m_lastRequest.fBold = fBold;
+        m_lastRequest.fItalic = fItalic;
+        m_lastRequest.fontPathsRevision = revision;
+    }
+    return m_lastRequest.fullFile;
+}
+
 //---------------------------------------------------------------------------------------
 bool FontStorage::select_font(const std::string& language,
                                const std::string& fontFile,
@@ -136,9 +189,8 @@ bool FontStorage::select_raster_font(const std::string& language,
                                       bool fBold, bool fItalic)
 {
     //Returns true if any error
-    FontSelector* fs = m_pLibScope->get_font_selector();
-    string fullFile = fs->find_font(language, fontFile, fontName, fBold, fItalic);
-    return set_font(fullFile, height, k_raster_font_cache);
+    return set_font(find_font_file(language, fontFile, fontName, fBold, fItalic),
+                    height, k_raster_font_cache);
 }
 
 //---------------------------------------------------------------------------------------
@@ -148,9 +200,8 @@ bool FontStorage::select_vector_font(const std::string& language,
                                       bool fBold, bool fItalic)
 {
     //Returns true if any error
-    FontSelector* fs = m_pLibScope->get_font_selector();
-    string fullFile = fs->find_font(language, fontFile, fontName, fBold, fItalic);
-    return set_font(fullFile, height, k_vector_font_cache);
+    return set_font(find_font_file(language, fontFile, fontName, fBold, fItalic),
+                    height, k_vector_font_cache);
 }
 
 
@@ -28,8 +28,8 @@ namespace lomse
 // SoundEventsTable: Manager for the events table
 //
 //    There are two tables to maintain:
-//    - m_events (std::vector<SoundEvent*>):
-//        Contains the MIDI events.
+//    - m_events (std::vector<SoundEvent>):
+//        Contains the MIDI events, stored by value in a contiguous table.
 //    - m_measures (std::vector<int>):
 //        Contains the index over m_events for the first event of each measure.
 //
@@ -57,19 +57,10 @@ SoundEventsTable::SoundEventsTable(ImoScore* pScore)
 //---------------------------------------------------------------------------------------
 SoundEventsTable::~SoundEventsTable()
 {
-    delete_events_table();
     delete_jumps_table();
     delete_measures_jumps_table();
 }
 
-//---------------------------------------------------------------------------------------
-void SoundEventsTable::delete_events_table()
-{
-    for (auto it : m_events)
-        delete it;
-    m_events.clear();
-}
-
 //---------------------------------------------------------------------------------------
 void SoundEventsTable::delete_jumps_table()
 {
@@ -336,17 +327,14 @@ void SoundEventsTable::store_event(TimeUnits rTime, int eventType, int channel,
                                    MidiPitch pitch, int volume, int step,
                                    ImoStaffObj* pSO, int measure)
 {
-    SoundEvent* pEvent = LOMSE_NEW SoundEvent(rTime, eventType, channel, pitch,
-                                              volume, step, pSO, measure);
-    m_events.push_back(pEvent);
+    m_events.emplace_back(rTime, eventType, channel, pitch, volume, step, pSO, measure);
     m_numMeasures = max(m_numMeasures, measure);
 }
 
 //---------------------------------------------------------------------------------------
 void SoundEventsTable::store_jump_event(TimeUnits rTime, JumpEntry* pJump, int measure)
 {
-    SoundEvent* pEvent = LOMSE_NEW SoundEvent(rTime, SoundEvent::k_jump, pJump, measure);
-    m_events.push_back(pEvent);
+    m_events.emplace_back(rTime, SoundEvent::k_jump, pJump, measure);
     m_numMeasures = max(m_numMeasures, measure);
 }
 
@@ -451,7 +439,7 @@ void SoundEventsTable::close_table()
 {
     TimeUnits maxTime = 0.0;
     if (m_events.size() > 0)
-        maxTime = TimeUnits(m_events.back()->DeltaTime);
+        maxTime = TimeUnits(m_events.back().DeltaTime);
     store_event(maxTime, SoundEvent::k_end_of_score, 0, 0, 0, 0, nullptr, 0);
 }
 
@@ -465,10 +453,10 @@ void SoundEventsTable::create_measures_table()
 
     for (int i=0; i < int(m_events.size()); i++)
     {
-        if (m_measures[m_events[i]->Measure] == -1)
+        if (m_measures[m_events[i].Measure] == -1)
         {
             //Add index to the table
-            m_measures[m_events[i]->Measure] = i;
+            m_measures[m_events[i].Measure] = i;
         }
     }
 
@@ -480,39 +468,20 @@ void SoundEventsTable::create_measures_table()
 //---------------------------------------------------------------------------------------
 void SoundEventsTable::sort_by_time()
 {
-    // Sort events by time, measure and event type. Uses the bubble sort algorithm
-
-    int j, k;
-    bool fChanges;
-    int nNumElements = int(m_events.size());
-    SoundEvent* pEvAux;
-
-    for (int i = 0; i < nNumElements; i++)
-    {
-        fChanges = false;
-        j = nNumElements - 1;
+    // Sort events by time, event type and measure. Event type goes before measure
+    // because at the same time the type priority must be respected (i.e. note off
+    // events before note on events). The sort is stable: events with the same keys
+    // keep the order in which they were created.
 
-        while ( j != i )
-        {
-            k = j - 1;
-            if ((m_events[j]->DeltaTime < m_events[k]->DeltaTime) ||
-                ((m_events[j]->DeltaTime == m_events[k]->DeltaTime) &&
-                 ((m_events[j]->Measure < m_events[k]->Measure) ||
-                  (m_events[j]->EventType < m_events[k]->EventType))))
-            {
-                //interchange elements
-                pEvAux = m_events[j];
-                m_events[j] = m_events[k];
-                m_events[k] = pEvAux;
-                fChanges = true;
-            }
-            j = k;
-        }
-
-        //If there were no changes in this loop step it implies that the table is ordered;
-        //in this case exit loop to save time
-        if (!fChanges) break;
-    }
+    std::stable_sort(m_events.begin(), m_events.end(),
+                     [](const SoundEvent& a, const SoundEvent& b)
+                     {
+                        if (a.DeltaTime != b.DeltaTime)
+                            return a.DeltaTime < b.DeltaTime;
+                        if (a.EventType != b.EventType)
+                            return a.EventType < b.EventType;
+                        return a.Measure < b.Measure;
+                     });
 }
 
 //---------------------------------------------------------------------------------------
@@ -541,7 +510,7 @@ string SoundEventsTable::dump_events_table()
             }
 
             //list current entry
-            SoundEvent* pSE = m_events[i];
+            SoundEvent* pSE = &m_events[i];
             msg << i << ":\t" << pSE->DeltaTime << "\t\t" << pSE->Channel << "\t"
                 << pSE->Measure << "\t";
 
@@ -606,7 +575,7 @@ string SoundEventsTable::dump_measures_table()
         int nEntry = m_measures[i];
         if (nEntry >= 0)
         {
-            SoundEvent* pSE = m_events[nEntry];
+            SoundEvent* pSE = &m_events[nEntry];
             msg << i << ":\t" << pSE->DeltaTime << "\t" << nEntry << "\n";
         }
         else
@@ -735,41 +704,41 @@ vector<MeasuresJumpsEntry*> SoundEventsTable::get_measures_jumps()
 
     //Execute control m_events that take place before firts play event
     size_t i = 0;
-    while ((m_events[i]->EventType == SoundEvent::k_prog_instr)
-           || (m_events[i]->EventType == SoundEvent::k_rhythm_change) )
+    while ((m_events[i].EventType == SoundEvent::k_prog_instr)
+           || (m_events[i].EventType == SoundEvent::k_rhythm_change) )
     {
         ++i;
     }
 
     //Here i points to the first event to play
     //loop to process m_events
-    int fromMeasure = m_events[i]->Measure;
-    TimeUnits fromTime = TimeUnits(m_events[i]->DeltaTime);
+    int fromMeasure = m_events[i].Measure;
+    TimeUnits fromTime = TimeUnits(m_events[i].DeltaTime);
     do
     {
         //if it is a jump event, execute the jump if applicable
-        if (m_events[i]->EventType == SoundEvent::k_jump)
+        if (m_events[i].EventType == SoundEvent::k_jump)
         {
             bool fExecuted = false;
-            JumpEntry* pJump = m_events[i]->pJump;
+            JumpEntry* pJump = m_events[i].pJump;
             if (pJump->get_visited() >= pJump->get_times_before())
             {
                 if (pJump->get_times_valid() == 0
                     || pJump->get_times_valid() > pJump->get_executed())
                 {
                     int iCur = i;
-                    long curTime =  m_events[iCur]->DeltaTime;     //the jmp entry time
+                    long curTime =  m_events[iCur].DeltaTime;     //the jmp entry time
                     i = pJump->get_event();
-                    TimeUnits jmpTime = TimeUnits(m_events[i]->DeltaTime);
+                    TimeUnits jmpTime = TimeUnits(m_events[i].DeltaTime);
                     if (pJump->get_times_valid() > pJump->get_executed())
                         pJump->increment_applied();
 
                     //find previous timepos (cur timepos is jmp entry timepos,
                     //that is, barline timepos, the start of next measure timepos)
                     int j=iCur;
-                    while (j > 0 && m_events[j]->DeltaTime == curTime)
+                    while (j > 0 && m_events[j].DeltaTime == curTime)
                         --j;
-                    curTime = m_events[j]->DeltaTime;
+                    curTime = m_events[j].DeltaTime;
 
                     //create the entry
                     m_measuresJumps.push_back(
@@ -798,7 +767,7 @@ vector<MeasuresJumpsEntry*> SoundEventsTable::get_measures_jumps()
 
     if (fromMeasure != -1)      //-1 = it finished before last measure (e.g. 'Fine' mark)
     {
-        TimeUnits curTime = TimeUnits(m_events[maxEvent-2]->DeltaTime);
+        TimeUnits curTime = TimeUnits(m_events[maxEvent-2].DeltaTime);
         m_measuresJumps.push_back(
             LOMSE_NEW MeasuresJumpsEntry(fromMeasure, fromTime, 0, curTime,       //0 = end of score
                                          int(maxEvent-2), curTime) );
@@ -24,7 +24,7 @@
 #include "lomse_im_note.h"
 
 #include <algorithm>    //max(), min()
-#include <ctime>        //clock()
+#include <chrono>
 
 
 namespace lomse
@@ -318,7 +318,7 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
 
     //TODO All issues related to sol-fa voice playback
 
-    std::vector<SoundEvent*>& events = m_pTable->get_events();
+    std::vector<SoundEvent>& events = m_pTable->get_events();
     if (events.size() == 0)
     {
         LOMSE_LOG_DEBUG(Logger::k_score_player, "<< Enter. No events to play. << Exit");
@@ -407,28 +407,28 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     bool fContinue = true;
     while (fContinue)
     {
-        if (events[i]->EventType == SoundEvent::k_prog_instr)
+        if (events[i].EventType == SoundEvent::k_prog_instr)
         {
             //change program
             switch (playMode)
             {
                 case k_play_rhythm_instrument:
-                    m_pMidi->voice_change(events[i]->Channel, 57);        //57 = Trumpet
+                    m_pMidi->voice_change(events[i].Channel, 57);        //57 = Trumpet
                     break;
                 case k_play_rhythm_percussion:
-                    m_pMidi->voice_change(events[i]->Channel, 66);        //66 = High Timbale
+                    m_pMidi->voice_change(events[i].Channel, 66);        //66 = High Timbale
                     break;
                 case k_play_rhythm_human_voice:
                     //do nothing. Wave sound will be used
                     break;
                 case k_play_normal_instrument:
                 default:
-                    m_pMidi->voice_change(events[i]->Channel, events[i]->Instrument);
+                    m_pMidi->voice_change(events[i].Channel, events[i].Instrument);
             }
         }
-        else if (events[i]->EventType == SoundEvent::k_rhythm_change)
+        else if (events[i].EventType == SoundEvent::k_rhythm_change)
         {
-            set_new_beat_information(events[i]);
+            set_new_beat_information(&events[i]);
 
             nMtrIntvalOff = min(7L, m_nMtrPulseDuration / 4L);            //click sound duration (interval to click off), in TU
             nMtrIntvalNextClick = m_nMtrPulseDuration - nMtrIntvalOff;    //interval from click off to next click, in TU
@@ -456,7 +456,7 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     //measure
     long curTime = 0L;
 	if (nEvStart > 1)
-		curTime = time_units_to_milliseconds( events[nEvStart]->DeltaTime );
+		curTime = time_units_to_milliseconds( events[nEvStart].DeltaTime );
 
 
     //determine last metronome pulse before first note to play.
@@ -468,7 +468,7 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     while (nMissingTime > 0)
         nMissingTime -= m_nMtrPulseDuration;
 
-    nMtrEvDeltaTime = ((events[i]->DeltaTime / m_nMtrPulseDuration) - 1) * m_nMtrPulseDuration;
+    nMtrEvDeltaTime = ((events[i].DeltaTime / m_nMtrPulseDuration) - 1) * m_nMtrPulseDuration;
     nMtrEvDeltaTime -= nMissingTime;
     curTime = time_units_to_milliseconds( nMtrEvDeltaTime );
     long nExtraTime = long( m_pTable->get_anacrusis_extra_time() );
@@ -476,7 +476,7 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     LOMSE_LOG_DEBUG(Logger::k_score_player,
                     "At start: nMtrEvDeltaTime=%ld, event=%d, event time=%ld, anacrusis missing time=%f, "
                     "curTime=%ld, nMissingTime=%ld, nExtraTime=%ld, nDeltaShift=%ld",
-                    nMtrEvDeltaTime, i, events[i]->DeltaTime, m_pTable->get_anacrusis_missing_time(),
+                    nMtrEvDeltaTime, i, events[i].DeltaTime, m_pTable->get_anacrusis_missing_time(),
                     curTime, nMissingTime, nExtraTime, nDeltaShift);
 
     //prepare weak_ptr to interactor
@@ -493,6 +493,15 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     SpEventVisualTracking pEvent(
             LOMSE_NEW EventVisualTracking(wpInteractor, m_pScore->get_id()) );
 
+    //Events are scheduled at absolute deadlines: curClock is the clock time for
+    //curTime. Waiting for an event is done until its deadline, so delays in
+    //waking up or in processing events do not accumulate
+    std::chrono::steady_clock::time_point curClock = std::chrono::steady_clock::now();
+    m_jitter = PlaybackJitter();
+
+    //sound requests for current time, sent together to the MIDI server
+    std::vector<MidiMessage> batch;
+
     bool fFirstBeatInMeasure = true;    //first beat of a measure
     bool fCountOffPulseActive = false;
 
@@ -514,9 +523,11 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
         for (int j=0 ; j < numPulses; ++j)
         {
             m_pMidi->note_on(m_MtrChannel, m_MtrTone2, 100);
-            std::this_thread::sleep_for( timeToOff );
+            curClock += timeToOff;
+            std::this_thread::sleep_until(curClock);
             m_pMidi->note_off(m_MtrChannel, m_MtrTone2, 100);
-            std::this_thread::sleep_for( timeToNext );
+            curClock += timeToNext;
+            std::this_thread::sleep_until(curClock);
         }
 
         //last click
@@ -535,11 +546,11 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     {
         LOMSE_LOG_DEBUG(Logger::k_score_player,
                         "new iteration: i=%d, curTime=%ld, nMtrEvDeltaTime=%ld, "
-                        "events[i]->DeltaTime=%ld",
-                        i, curTime, nMtrEvDeltaTime, events[i]->DeltaTime);
+                        "events[i].DeltaTime=%ld",
+                        i, curTime, nMtrEvDeltaTime, events[i].DeltaTime);
 
         //Verify if next event is a metronome click on/off
-        if (nMtrEvDeltaTime <= events[i]->DeltaTime)
+        if (nMtrEvDeltaTime <= events[i].DeltaTime)
         {
             //Next event should be a metronome click or the click off event for the previous metronome click
             nEvTime = time_units_to_milliseconds(nMtrEvDeltaTime);
@@ -547,10 +558,9 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
             if (curTime < nEvTime)
             {
                 //flush pending events
-                long elapsed = 0L;
+                send_midi_messages(batch);
                 if (fVisualTracking && pEvent->get_num_items() > 0)
                 {
-                    clock_t t1=clock();
                     if (m_fPostEvents)
                         m_libScope.post_event(pEvent);
                     else if (pInteractor)
@@ -558,20 +568,13 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
                     pEvent = SpEventVisualTracking(
                                 LOMSE_NEW EventVisualTracking(wpInteractor,
                                                               m_pScore->get_id()) );
-                    clock_t t2=clock();
-                    elapsed = long( ((t2-t1)*1000.0)/double(CLOCKS_PER_SEC));
                 }
 
                 //wait for current time
-                long waitT = nEvTime - curTime - elapsed;
-                if (waitT > 0L)
-                {
-                    std::chrono::milliseconds waitTime(waitT);
-                    std::this_thread::sleep_for(waitTime);
-                }
+                curClock = wait_until(curClock, nEvTime - curTime);
                 curTime = nEvTime;
-                LOMSE_LOG_DEBUG(Logger::k_score_player, "flush pending events: waitT=%ld, new curTime=%ld",
-                                waitT, curTime);
+                LOMSE_LOG_DEBUG(Logger::k_score_player, "flush pending events: new curTime=%ld",
+                                curTime);
             }
 
             if (fSendMtrOff)
@@ -580,9 +583,9 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
                 if (fPlayWithMetronome || fCountOffPulseActive)
                 {
                     if (fFirstBeatInMeasure)
-                        m_pMidi->note_off(m_MtrChannel, m_MtrTone1, 127);
+                        batch.emplace_back(MidiMessage::k_note_off, m_MtrChannel, m_MtrTone1, 127);
                     else
-                        m_pMidi->note_off(m_MtrChannel, m_MtrTone2, 80);
+                        batch.emplace_back(MidiMessage::k_note_off, m_MtrChannel, m_MtrTone2, 80);
 
                     fCountOffPulseActive = false;
                 }
@@ -601,9 +604,9 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
                 if (fPlayWithMetronome)
                 {
                     if (fFirstBeatInMeasure)
-                        m_pMidi->note_on(m_MtrChannel, m_MtrTone1, 127);
+                        batch.emplace_back(MidiMessage::k_note_on, m_MtrChannel, m_MtrTone1, 127);
                     else
-                        m_pMidi->note_on(m_MtrChannel, m_MtrTone2, 80);
+                        batch.emplace_back(MidiMessage::k_note_on, m_MtrChannel, m_MtrTone2, 80);
                 }
 
                 if (fVisualTracking && nMtrEvDeltaTime >= 0L)
@@ -627,17 +630,16 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
         else
         {
             //next even comes from the table. Usually it will be a note on/off
-            nEvTime = time_units_to_milliseconds( events[i]->DeltaTime );
+            nEvTime = time_units_to_milliseconds( events[i].DeltaTime );
             LOMSE_LOG_DEBUG(Logger::k_score_player, "nEvTime updated (event i) = %ld", nEvTime);
             if (nEvTime > curTime)
             {
                 //flush accumulated events for curTime
-                long elapsed = 0L;
+                send_midi_messages(batch);
                 if (fVisualTracking && pEvent->get_num_items() > 0)
                 {
                     LOMSE_LOG_DEBUG(Logger::k_events | Logger::k_score_player,
                                     "Flush pending events");
-                    clock_t t1=clock();
                     if (m_fPostEvents)
                         m_libScope.post_event(pEvent);
                     else if (pInteractor)
@@ -645,33 +647,26 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
                     pEvent = SpEventVisualTracking(
                                 LOMSE_NEW EventVisualTracking(wpInteractor,
                                                               m_pScore->get_id()) );
-                    clock_t t2=clock();
-                    elapsed = long( ((t2-t1)*1000.0)/double(CLOCKS_PER_SEC));
                 }
 
                 //wait until new time arrives
-                long waitT = nEvTime - curTime - elapsed;
-                if (waitT > 0L)
-                {
-                    std::chrono::milliseconds waitTime(waitT);
-                    std::this_thread::sleep_for(waitTime);
-                }
+                curClock = wait_until(curClock, nEvTime - curTime);
             }
 
             //if it is a jump event, execute the jump if applicable
-            if (events[i]->EventType == SoundEvent::k_jump)
+            if (events[i].EventType == SoundEvent::k_jump)
             {
                 bool fExecuted = false;
-                JumpEntry* pJump = events[i]->pJump;
+                JumpEntry* pJump = events[i].pJump;
                 if (pJump->get_visited() >= pJump->get_times_before())
                 {
                     if (pJump->get_times_valid() == 0
                         || pJump->get_times_valid() > pJump->get_executed())
                     {
                         i = pJump->get_event();
-                        nEvTime = time_units_to_milliseconds( events[i]->DeltaTime );
+                        nEvTime = time_units_to_milliseconds( events[i].DeltaTime );
                         curTime = nEvTime;
-                        nMtrEvDeltaTime = events[i]->DeltaTime;
+                        nMtrEvDeltaTime = events[i].DeltaTime;
                         if (pJump->get_times_valid() > pJump->get_executed())
                             pJump->increment_applied();
                         fExecuted = true;
@@ -687,98 +682,99 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
             }
 
 
-            if (events[i]->EventType == SoundEvent::k_note_on)
+            if (events[i].EventType == SoundEvent::k_note_on)
             {
                 //start of note
                 switch(playMode)
                 {
                     case k_play_rhythm_instrument:
-                        m_pMidi->note_on(events[i]->Channel, k_SOLFA_NOTE,
-                                        events[i]->Volume);
+                        batch.emplace_back(MidiMessage::k_note_on, events[i].Channel,
+                                           k_SOLFA_NOTE, events[i].Volume);
                         break;
                     case k_play_rhythm_percussion:
-                        m_pMidi->note_on(nPercussionChannel, k_SOLFA_NOTE,
-                                        events[i]->Volume);
+                        batch.emplace_back(MidiMessage::k_note_on, nPercussionChannel,
+                                           k_SOLFA_NOTE, events[i].Volume);
                         break;
                     case k_play_rhythm_human_voice:
-                        //WaveOn .NoteStep, events[i]->Volume);
+                        //WaveOn .NoteStep, events[i].Volume);
                         break;
                     case k_play_normal_instrument:
                     default:
-                        m_pMidi->note_on(events[i]->Channel, events[i]->NotePitch,
-                                        events[i]->Volume);
+                        batch.emplace_back(MidiMessage::k_note_on, events[i].Channel,
+                                           events[i].NotePitch, events[i].Volume);
                 }
 
                 //generate implicit visual on event
-                if (fVisualTracking && events[i]->pSO->is_visible())
+                if (fVisualTracking && events[i].pSO->is_visible())
                 {
-                    ImoId id = events[i]->pSO->get_id();
+                    ImoId id = events[i].pSO->get_id();
                     pEvent->add_item(EventVisualTracking::k_highlight_on, id);
                     LOMSE_LOG_DEBUG(Logger::k_events | Logger::k_score_player,
                                     "implicit k_highlight_on generated for %d", id);
                 }
                 LOMSE_LOG_DEBUG(Logger::k_score_player, "Note On");
             }
-            else if (events[i]->EventType == SoundEvent::k_note_off)
+            else if (events[i].EventType == SoundEvent::k_note_off)
             {
                 //end of note
                 switch(playMode)
                 {
                     case k_play_rhythm_instrument:
-                        m_pMidi->note_off(events[i]->Channel, k_SOLFA_NOTE, 127);
+                        batch.emplace_back(MidiMessage::k_note_off, events[i].Channel, k_SOLFA_NOTE, 127);
                         break;
                     case k_play_rhythm_percussion:
-                        m_pMidi->note_off(nPercussionChannel, k_SOLFA_NOTE, 127);
+                        batch.emplace_back(MidiMessage::k_note_off, nPercussionChannel, k_SOLFA_NOTE, 127);
                         break;
                     case k_play_rhythm_human_voice:
                         //WaveOff
                         break;
                     case k_play_normal_instrument:
                     default:
-                        m_pMidi->note_off(events[i]->Channel, events[i]->NotePitch, 127);
+                        batch.emplace_back(MidiMessage::k_note_off, events[i].Channel,
+                                           events[i].NotePitch, 127);
                 }
 
                 //generate implicit visual off event
-                if (fVisualTracking && events[i]->pSO->is_visible())
+                if (fVisualTracking && events[i].pSO->is_visible())
                 {
-                    pEvent->add_item(EventVisualTracking::k_highlight_off, events[i]->pSO->get_id());
+                    pEvent->add_item(EventVisualTracking::k_highlight_off, events[i].pSO->get_id());
                     LOMSE_LOG_DEBUG(Logger::k_events | Logger::k_score_player,
                                     "implicit k_highlight_off generated for %d",
-                                    events[i]->pSO->get_id());
+                                    events[i].pSO->get_id());
                 }
                 LOMSE_LOG_DEBUG(Logger::k_score_player, "Note Off");
             }
-            else if (events[i]->EventType == SoundEvent::k_visual_on)
+            else if (events[i].EventType == SoundEvent::k_visual_on)
             {
                 //set visual highlight
                 if (fVisualTracking)
                 {
-                    ImoId id = events[i]->pSO->get_id();
+                    ImoId id = events[i].pSO->get_id();
                     pEvent->add_item(EventVisualTracking::k_highlight_on, id);
                     LOMSE_LOG_DEBUG(Logger::k_events | Logger::k_score_player,
                                     "explicit k_highlight_on generated for %d", id);
                 }
             }
-            else if (events[i]->EventType == SoundEvent::k_visual_off)
+            else if (events[i].EventType == SoundEvent::k_visual_off)
             {
                 //remove visual highlight
                 if (fVisualTracking)
                 {
-                    pEvent->add_item(EventVisualTracking::k_highlight_off, events[i]->pSO->get_id());
+                    pEvent->add_item(EventVisualTracking::k_highlight_off, events[i].pSO->get_id());
                     LOMSE_LOG_DEBUG(Logger::k_events | Logger::k_score_player,
                                     "explicit k_highlight_off generated for %d",
-                                    events[i]->pSO->get_id());
+                                    events[i].pSO->get_id());
                 }
 
             }
-            else if (events[i]->EventType == SoundEvent::k_end_of_score)
+            else if (events[i].EventType == SoundEvent::k_end_of_score)
             {
                 //end of table
                 break;
             }
-            else if (events[i]->EventType == SoundEvent::k_rhythm_change)
+            else if (events[i].EventType == SoundEvent::k_rhythm_change)
             {
-                set_new_beat_information(events[i]);
+                set_new_beat_information(&events[i]);
 
                 nMtrIntvalOff = min(7L, m_nMtrPulseDuration / 4L);            //click duration (interval to click off)
                 nMtrIntvalNextClick = m_nMtrPulseDuration - nMtrIntvalOff;    //interval from click off to next click
@@ -787,23 +783,24 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
                                 "new TS: nCurMeasureDuration=%ld, nCurMtrIntval=%ld",
                                 m_nCurMeasureDuration, m_nCurMtrIntval);
             }
-            else if (events[i]->EventType == SoundEvent::k_prog_instr)
+            else if (events[i].EventType == SoundEvent::k_prog_instr)
             {
                 //change program
                 switch (playMode)
                 {
                     case k_play_rhythm_instrument:
-                        m_pMidi->voice_change(events[i]->Channel, 57);        //57 = Trumpet
+                        batch.emplace_back(MidiMessage::k_voice_change, events[i].Channel, 57);        //57 = Trumpet
                         break;
                     case k_play_rhythm_percussion:
-                        m_pMidi->voice_change(events[i]->Channel, 66);        //66 = High Timbale
+                        batch.emplace_back(MidiMessage::k_voice_change, events[i].Channel, 66);        //66 = High Timbale
                         break;
                     case k_play_rhythm_human_voice:
                         //do nothing. Wave sound will be used
                         break;
                     case k_play_normal_instrument:
                     default:
-                        m_pMidi->voice_change(events[i]->Channel, events[i]->NotePitch);
+                        batch.emplace_back(MidiMessage::k_voice_change, events[i].Channel,
+                                           events[i].NotePitch);
                 }
             }
             else
@@ -824,14 +821,21 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
             LOMSE_LOG_DEBUG(Logger::k_score_player, "Going to finish 1");
             break;
         }
-        while(m_fPaused)
+        if (m_fPaused)
         {
-            std::this_thread::sleep_for( std::chrono::milliseconds(200) );
-            if (m_fShouldStop)
+            //sounds are muted when pausing. Discard pending sounds
+            batch.clear();
+            while(m_fPaused)
             {
-                LOMSE_LOG_DEBUG(Logger::k_score_player, "Going to finish 2");
-                break;
+                std::this_thread::sleep_for( std::chrono::milliseconds(200) );
+                if (m_fShouldStop)
+                {
+                    LOMSE_LOG_DEBUG(Logger::k_score_player, "Going to finish 2");
+                    break;
+                }
             }
+            //restart the clock, so that playback continues at current time
+            curClock = std::chrono::steady_clock::now();
         }
 
         //update metronome information, just in case metronome was updated
@@ -857,6 +861,9 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
 
     } while (i <= nEvEnd);
 
+    //send sounds for last processed events
+    send_midi_messages(batch);
+
     //TODO: Last Highlight event (note off) is not send because loop break at line
     // 690 without sending last event. It is not important as next event will remove all
     // highlight but should be studied and decided. Can be sent here.
@@ -878,6 +885,37 @@ void ScorePlayer::do_play(int nEvStart, int nEvEnd, bool fVisualTracking,
     LOMSE_LOG_DEBUG(Logger::k_score_player, "<< Exit");
 }
 
+//---------------------------------------------------------------------------------------
+std::chrono::steady_clock::time_point
+ScorePlayer::wait_until(std::chrono::steady_clock::time_point curClock, long waitTime)
+{
+    //Waits until the deadline for the next event, waitTime milliseconds after the
+    //deadline for current event, and returns the new deadline. Delay in waking up
+    //is saved for jitter statistics
+
+    std::chrono::steady_clock::time_point deadline =
+        curClock + std::chrono::milliseconds(waitTime);
+    std::this_thread::sleep_until(deadline);
+
+    long delay = long( std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - deadline).count() );
+    ++m_jitter.numTicks;
+    m_jitter.totalDelay += delay;
+    m_jitter.maxDelay = max(m_jitter.maxDelay, delay);
+
+    return deadline;
+}
+
+//---------------------------------------------------------------------------------------
+void ScorePlayer::send_midi_messages(std::vector<MidiMessage>& batch)
+{
+    if (!batch.empty())
+    {
+        m_pMidi->send_messages(batch);
+        batch.clear();
+    }
+}
+
 //---------------------------------------------------------------------------------------
 void ScorePlayer::end_of_playback_housekeeping(bool fVisualTracking,
                                                Interactor* pInteractor)
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#define LOMSE_INTERNAL_API
+#include <UnitTest++.h>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include "lomse_build_options.h"
+
+//classes related to these tests
+#include "lomse_injectors.h"
+#include "lomse_bitmap_drawer.h"
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+//---------------------------------------------------------------------------------------
+class BitmapDrawerTestFixture
+{
+public:
+    LibraryScope m_libraryScope;
+    std::vector<unsigned char> m_buffer;
+    int m_width;
+    int m_height;
+    double m_scale;
+
+    BitmapDrawerTestFixture()     //SetUp fixture
+        : m_libraryScope(cout)
+        , m_width(40)
+        , m_height(30)
+        , m_scale(1.0)
+    {
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+        m_buffer.resize(m_width * m_height * 4);
+    }
+
+    ~BitmapDrawerTestFixture()    //TearDown fixture
+    {
+    }
+
+    BitmapDrawer* create_drawer()
+    {
+        BitmapDrawer* pDrawer = Injector::inject_BitmapDrawer(m_libraryScope);
+        pDrawer->set_rendering_buffer(&m_buffer[0], m_width, m_height);
+        m_scale = pDrawer->model_to_device_units(1.0);
+        return pDrawer;
+    }
+
+    LUnits px(double pixels)
+    {
+        //logical units for the given number of pixels
+        return LUnits(pixels / m_scale);
+    }
+
+    int red(int x, int y)
+    {
+        return m_buffer[(y * m_width + x) * 4];
+    }
+};
+
+
+SUITE(BitmapDrawerTest)
+{
+
+    TEST_FIXTURE(BitmapDrawerTestFixture, filled_rectangle_01)
+    {
+        //@01. filled rectangle. Inner pixels fully covered, edges partially covered
+
+        BitmapDrawer* pDrawer = create_drawer();
+        CHECK( pDrawer->accepts_filled_rectangles() == true );
+
+        pDrawer->filled_rectangle(px(5.5), px(10.0), px(20.0), px(12.5), Color(0, 0, 0));
+        pDrawer->render();
+
+        CHECK( red(10, 10) == 0 );
+        CHECK( red(19, 11) == 0 );
+        CHECK( red(10, 12) > 0 && red(10, 12) < 255 );
+        CHECK( red(5, 11) > 0 && red(5, 11) < 255 );
+        CHECK( red(10, 9) == 255 );
+        CHECK( red(20, 11) == 255 );
+        CHECK( red(10, 13) == 255 );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(BitmapDrawerTestFixture, filled_rectangle_02)
+    {
+        //@02. filled rectangle. Same result as rendering the rectangle as a path
+
+        BitmapDrawer* pDrawer = create_drawer();
+        pDrawer->begin_path();
+        pDrawer->fill(Color(0, 0, 0));
+        pDrawer->stroke_none();
+        pDrawer->rect(UPoint(px(3.3), px(4.6)), USize(px(30.4), px(1.7)), 0.0f);
+        pDrawer->end_path();
+        pDrawer->begin_path();
+        pDrawer->rect(UPoint(px(8.25), px(9.0)), USize(px(1.2), px(15.5)), 0.0f);
+        pDrawer->end_path();
+        pDrawer->render();
+        std::vector<unsigned char> expected = m_buffer;
+        delete pDrawer;
+
+        pDrawer = create_drawer();
+        pDrawer->filled_rectangle(px(3.3), px(4.6), px(33.7), px(6.3), Color(0, 0, 0));
+        pDrawer->filled_rectangle(px(8.25), px(9.0), px(9.45), px(24.5), Color(0, 0, 0));
+        pDrawer->render();
+
+        int maxDiff = 0;
+        for (size_t i=0; i < m_buffer.size(); ++i)
+            maxDiff = max(maxDiff, abs(int(m_buffer[i]) - int(expected[i])));
+        CHECK( maxDiff <= 4 );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(BitmapDrawerTestFixture, filled_rectangle_03)
+    {
+        //@03. filled rectangle. Clipped to the rendering buffer
+
+        BitmapDrawer* pDrawer = create_drawer();
+        pDrawer->filled_rectangle(px(-10.0), px(25.0), px(60.0), px(45.0), Color(0, 0, 0));
+        pDrawer->render();
+
+        CHECK( red(0, 25) == 0 );
+        CHECK( red(m_width-1, m_height-1) == 0 );
+        CHECK( red(0, 24) == 255 );
+
+        delete pDrawer;
+    }
+
+}
+
@@ -5322,4 +5322,123 @@ SUITE(DocCommandTest)
         CHECK( (*cursor)->to_string() == "(n f4 e v1 p1)" );
     }
 
+    // DocCommandExecuter checkpoints ---------------------------------------------------
+
+    TEST_FIXTURE(DocCommandTestFixture, checkpoints_9001)
+    {
+        //checkpoint taken every n commands. Undo/redo from checkpoints
+        MyDocument3 doc(m_libraryScope);
+        doc.from_string("(score (vers 2.0)(instrument#90 (musicData#122 (clef G))))");
+        doc.my_clear_dirty();
+        DocCommandExecuter executer(&doc);
+        executer.set_checkpoints_policy(2, 0, 10);
+        DocCursor cursor(&doc);
+        cursor.enter_element();
+        cursor.move_next();
+        MySelectionSet sel(&doc);
+
+        for (int i=0; i < 5; ++i)
+            executer.execute(&cursor, LOMSE_NEW CmdInsertStaffObj("(n c4 q)"), &sel);
+
+        CHECK( executer.undo_stack_size() == 5 );
+        CHECK( executer.num_checkpoints() == 2 );
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        CHECK( pScore->get_staffobjs_table()->num_entries() == 6 );
+
+        for (int i=5; i > 0; --i)
+        {
+            executer.undo(&cursor, &sel);
+            pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+            CHECK( pScore->get_staffobjs_table()->num_entries() == i );
+        }
+        CHECK( executer.num_checkpoints() == 0 );
+        CHECK( *cursor == nullptr );
+
+        for (int i=1; i <= 5; ++i)
+        {
+            executer.redo(&cursor, &sel);
+            pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+            CHECK( pScore->get_staffobjs_table()->num_entries() == i+1 );
+        }
+    }
+
+    TEST_FIXTURE(DocCommandTestFixture, checkpoints_9002)
+    {
+        //max number of checkpoints is respected. Oldest are discarded
+        MyDocument3 doc(m_libraryScope);
+        doc.from_string("(score (vers 2.0)(instrument#90 (musicData#122 (clef G))))");
+        doc.my_clear_dirty();
+        DocCommandExecuter executer(&doc);
+        executer.set_checkpoints_policy(1, 0, 3);
+        DocCursor cursor(&doc);
+        cursor.enter_element();
+        cursor.move_next();
+        MySelectionSet sel(&doc);
+
+        for (int i=0; i < 6; ++i)
+            executer.execute(&cursor, LOMSE_NEW CmdInsertStaffObj("(n c4 q)"), &sel);
+
+        CHECK( executer.num_checkpoints() == 3 );
+
+        //undo all: first undos use checkpoints, last ones replay from start
+        for (int i=6; i > 0; --i)
+        {
+            executer.undo(&cursor, &sel);
+            ImoScore* pScore =
+                static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+            CHECK( pScore->get_staffobjs_table()->num_entries() == i );
+        }
+        CHECK( executer.num_checkpoints() == 0 );
+    }
+
+    TEST_FIXTURE(DocCommandTestFixture, checkpoints_9003)
+    {
+        //checkpoints disabled: undo replays from start
+        MyDocument3 doc(m_libraryScope);
+        doc.from_string("(score (vers 2.0)(instrument#90 (musicData#122 (clef G))))");
+        doc.my_clear_dirty();
+        DocCommandExecuter executer(&doc);
+        executer.set_checkpoints_policy(1, 0, 0);
+        DocCursor cursor(&doc);
+        cursor.enter_element();
+        cursor.move_next();
+        MySelectionSet sel(&doc);
+
+        for (int i=0; i < 3; ++i)
+            executer.execute(&cursor, LOMSE_NEW CmdInsertStaffObj("(n c4 q)"), &sel);
+
+        CHECK( executer.num_checkpoints() == 0 );
+        executer.undo(&cursor, &sel);
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        CHECK( pScore->get_staffobjs_table()->num_entries() == 3 );
+    }
+
+    TEST_FIXTURE(DocCommandTestFixture, checkpoints_9004)
+    {
+        //checkpoints are also taken when redoing commands
+        MyDocument3 doc(m_libraryScope);
+        doc.from_string("(score (vers 2.0)(instrument#90 (musicData#122 (clef G))))");
+        doc.my_clear_dirty();
+        DocCommandExecuter executer(&doc);
+        executer.set_checkpoints_policy(2, 0, 10);
+        DocCursor cursor(&doc);
+        cursor.enter_element();
+        cursor.move_next();
+        MySelectionSet sel(&doc);
+
+        for (int i=0; i < 4; ++i)
+            executer.execute(&cursor, LOMSE_NEW CmdInsertStaffObj("(n c4 q)"), &sel);
+        for (int i=0; i < 4; ++i)
+            executer.undo(&cursor, &sel);
+        CHECK( executer.num_checkpoints() == 0 );
+
+        for (int i=0; i < 4; ++i)
+            executer.redo(&cursor, &sel);
+        CHECK( executer.num_checkpoints() == 2 );
+
+        executer.undo(&cursor, &sel);
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        CHECK( pScore->get_staffobjs_table()->num_entries() == 4 );
+    }
+
 }
@@ -0,0 +1,332 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#define LOMSE_INTERNAL_API
+#include <UnitTest++.h>
+#include <sstream>
+#include <vector>
+#include "lomse_build_options.h"
+
+//classes related to these tests
+#include "lomse_injectors.h"
+#include "lomse_display_list.h"
+#include "lomse_bitmap_drawer.h"
+#include "lomse_graphical_model.h"
+#include "lomse_gm_basic.h"
+#include "private/lomse_document_p.h"
+#include "lomse_interactor.h"
+#include "lomse_graphic_view.h"
+#include "lomse_doorway.h"
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+
+//---------------------------------------------------------------------------------------
+class DisplayListTestDoorway : public LomseDoorway
+{
+protected:
+    RenderingBuffer m_buffer;
+
+public:
+    DisplayListTestDoorway()
+        : LomseDoorway()
+    {
+        init_library(k_pix_format_rgba32, 96);
+    }
+    virtual ~DisplayListTestDoorway() {}
+
+    void set_window_title(const std::string& UNUSED(title)) {}
+    void force_redraw() {}
+    RenderingBuffer& get_window_buffer() { return m_buffer; }
+    double get_screen_ppi() const { return 96.0; }
+};
+
+//---------------------------------------------------------------------------------------
+class DisplayListTestFixture
+{
+public:
+    DisplayListTestDoorway m_doorway;
+    LibraryScope m_libraryScope;
+    Interactor* m_pIntor;
+    SpDocument m_spDoc;
+    int m_width;
+    int m_height;
+
+    DisplayListTestFixture()     //SetUp fixture
+        : m_libraryScope(cout, &m_doorway)
+        , m_pIntor(nullptr)
+        , m_width(800)
+        , m_height(1130)
+    {
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+    }
+
+    ~DisplayListTestFixture()    //TearDown fixture
+    {
+        delete m_pIntor;
+    }
+
+    GmoBoxDocPage* create_page(const string& src)
+    {
+        m_spDoc.reset( new Document(m_libraryScope) );
+        m_spDoc->from_string(src);
+        View* pView = Injector::inject_View(m_libraryScope, k_view_vertical_book);
+        m_pIntor = Injector::inject_Interactor(m_libraryScope, WpDocument(m_spDoc),
+                                               pView, nullptr);
+        return m_pIntor->get_graphic_model()->get_page(0);
+    }
+
+    BitmapDrawer* create_drawer(std::vector<unsigned char>& buffer)
+    {
+        buffer.assign(m_width * m_height * 4, 0);
+        BitmapDrawer* pDrawer = Injector::inject_BitmapDrawer(m_libraryScope);
+        pDrawer->set_rendering_buffer(&buffer[0], m_width, m_height);
+        pDrawer->reset(Color(255, 255, 255));
+        return pDrawer;
+    }
+};
+
+
+SUITE(DisplayListTest)
+{
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_01)
+    {
+        //@01. Replaying the display list gives the same image as drawing the page
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(key D)(time 2 4)(n c4 e g+)(n e4 e g-)(r q)(barline)"
+            "(n f5 q.)(n g5 e)(barline))))");
+        RenderOptions opt;
+
+        std::vector<unsigned char> expected;
+        BitmapDrawer* pDrawer = create_drawer(expected);
+        pPage->on_draw(pDrawer, opt);
+        pDrawer->render();
+        delete pDrawer;
+
+        std::vector<unsigned char> buffer;
+        pDrawer = create_drawer(buffer);
+        pPage->draw_using_display_list(pDrawer, opt);
+        pDrawer->render();
+
+        CHECK( pPage->get_display_list() != nullptr );
+        CHECK( pPage->get_display_list()->num_commands() > 0 );
+        CHECK( buffer == expected );
+        CHECK( buffer != std::vector<unsigned char>(buffer.size(), 255) );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_02)
+    {
+        //@02. The display list is reused in next drawings
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(n c4 q)(r q)(barline))))");
+        RenderOptions opt;
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        pPage->draw_using_display_list(pDrawer, opt);
+        DisplayList* pList = pPage->get_display_list();
+
+        pPage->draw_using_display_list(pDrawer, opt);
+
+        CHECK( pList != nullptr );
+        CHECK( pPage->get_display_list() == pList );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_03)
+    {
+        //@03. The display list is discarded when the page content changes
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(n c4 q)(r q)(barline))))");
+        RenderOptions opt;
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        pPage->draw_using_display_list(pDrawer, opt);
+        CHECK( pPage->get_display_list() != nullptr );
+
+        GmoBox* pBox = pPage->get_child_box(0);
+        pBox->set_dirty(true);
+
+        CHECK( pPage->get_display_list() == nullptr );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_04)
+    {
+        //@04. The display list is recorded again when the render options change
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(n c4 q)(r q)(barline))))");
+        RenderOptions opt;
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        pPage->draw_using_display_list(pDrawer, opt);
+        size_t numCommands = pPage->get_display_list()->num_commands();
+
+        opt.draw_shape_bounds = true;
+        CHECK( pPage->get_display_list()->is_valid_for(pDrawer, opt) == false );
+        pPage->draw_using_display_list(pDrawer, opt);
+
+        CHECK( pPage->get_display_list()->is_valid_for(pDrawer, opt) == true );
+        CHECK( pPage->get_display_list()->num_commands() > numCommands );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_05)
+    {
+        //@05. Objects out of the clipping rectangle are not replayed
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(n c4 q)(r q)(barline))))");
+        RenderOptions opt;
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        pPage->draw_using_display_list(pDrawer, opt);
+        delete pDrawer;
+
+        std::vector<unsigned char> clipped;
+        pDrawer = create_drawer(clipped);
+        opt.use_clip_rect = true;
+        opt.clip_rect = URect(-2000.0f, -2000.0f, 1000.0f, 1000.0f);
+        pPage->draw_using_display_list(pDrawer, opt);
+        pDrawer->render();
+
+        //nothing drawn
+        std::vector<unsigned char> white(clipped.size(), 255);
+        CHECK( clipped == white );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_06)
+    {
+        //@06. Font selection is recorded and reported as successful (no error)
+
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        RenderOptions opt;
+        DisplayList list(pDrawer, opt);
+        RecordingDrawer recorder(pDrawer, &list);
+
+        CHECK( recorder.select_font("en", "", "Liberation serif", 12.0) == false );
+        CHECK( list.num_commands() == 1 );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_07)
+    {
+        //@07. The display list is discarded when a shape is moved, even when the
+        //@    drawing bounds of its box are already invalid
+
+        GmoBoxDocPage* pPage = create_page("(score (vers 2.0)(instrument "
+            "(musicData (clef G)(n c4 q)(r q)(barline))))");
+        RenderOptions opt;
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        GmoShape* pShape = pPage->get_first_shape_for_layer(GmoShape::k_layer_staff);
+        CHECK( pShape != nullptr );
+
+        pPage->draw_using_display_list(pDrawer, opt);
+        pShape->shift_origin(USize(100.0f, 0.0f));
+        CHECK( pPage->get_display_list() == nullptr );
+
+        //record again without computing the drawing bounds of the boxes
+        DisplayList* pList = LOMSE_NEW DisplayList(pDrawer, opt);
+        pPage->set_display_list(pList);
+        pShape->shift_origin(USize(100.0f, 0.0f));
+        CHECK( pPage->get_display_list() == nullptr );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_08)
+    {
+        //@08. Bitmaps are copied. Replay does not depend on the original buffer
+
+        std::vector<unsigned char> pixels(20 * 20 * 4, 0);
+        for (size_t i=0; i < pixels.size(); i += 4)
+        {
+            pixels[i] = 255;        //opaque red
+            pixels[i+3] = 255;
+        }
+        RenderingBuffer bmap(&pixels[0], 20, 20, 20 * 4);
+
+        std::vector<unsigned char> expected;
+        BitmapDrawer* pDrawer = create_drawer(expected);
+        RenderOptions opt;
+        pDrawer->draw_bitmap(bmap, true, 0, 0, 20, 20, 0.0f, 0.0f, 500.0f, 500.0f,
+                             k_quality_low);
+        pDrawer->render();
+
+        DisplayList list(pDrawer, opt);
+        RecordingDrawer recorder(pDrawer, &list);
+        recorder.draw_bitmap(bmap, true, 0, 0, 20, 20, 0.0f, 0.0f, 500.0f, 500.0f,
+                             k_quality_low);
+        delete pDrawer;
+        pixels.assign(pixels.size(), 0);
+
+        std::vector<unsigned char> buffer;
+        pDrawer = create_drawer(buffer);
+        list.replay(pDrawer, opt);
+        pDrawer->render();
+
+        CHECK( buffer == expected );
+        CHECK( buffer != std::vector<unsigned char>(buffer.size(), 255) );
+
+        delete pDrawer;
+    }
+
+    TEST_FIXTURE(DisplayListTestFixture, display_list_09)
+    {
+        //@09. Display lists for pages not recently drawn are discarded when the
+        //@    memory budget is exceeded
+
+        stringstream src;
+        src << "(score (vers 2.0)(instrument (musicData (clef G)";
+        for (int i=0; i < 300; ++i)
+            src << "(n c4 s)(n e4 s)(n g4 s)(n c5 s)(barline)";
+        src << ")))";
+        create_page(src.str());
+        GraphicModel* pGModel = m_pIntor->get_graphic_model();
+        CHECK( pGModel->get_num_pages() > 2 );
+
+        std::vector<unsigned char> buffer;
+        BitmapDrawer* pDrawer = create_drawer(buffer);
+        RenderOptions opt;
+        UPoint origin(0.0f, 0.0f);
+        pGModel->draw_page(0, origin, pDrawer, opt);
+        pGModel->draw_page(1, origin, pDrawer, opt);
+        CHECK( pGModel->get_page(0)->get_display_list() != nullptr );
+        CHECK( pGModel->get_page(1)->get_display_list() != nullptr );
+
+        //budget for just one page
+        pGModel->set_display_lists_budget(
+                        pGModel->get_page(1)->get_display_list_memory() + 1 );
+        pGModel->draw_page(2, origin, pDrawer, opt);
+
+        CHECK( pGModel->get_page(0)->get_display_list() == nullptr );
+        CHECK( pGModel->get_page(1)->get_display_list() == nullptr );
+        CHECK( pGModel->get_page(2)->get_display_list() != nullptr );
+        CHECK( pGModel->get_page(2)->get_display_list_memory() > 0 );
+
+        delete pDrawer;
+    }
+
+}
@@ -21,6 +21,7 @@
 #include "lomse_id_assigner.h"
 #include "lomse_staffobjs_table.h"
 #include "lomse_mxl_exporter.h"
+#include "lomse_im_arena.h"
 
 using namespace UnitTest;
 using namespace std;
@@ -518,6 +519,48 @@ SUITE(DocModelTest)
         delete pModelCopy;
     }
 
+#if (LOMSE_ENABLE_IM_ARENA == 1)
+    TEST_FIXTURE(DocModelTestFixture, arena_01)
+    {
+        //@01. Objects are allocated in the arena of the model that owns them
+
+        Document doc(m_libraryScope);
+        doc.from_string("(score (vers 2.0)(instrument (musicData (clef G)(n c4 q)"
+                        "(barline))))");
+
+        DocModel* pModel = doc.get_doc_model();
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        CHECK( ImArena::get_arena_for(pScore) == pModel->get_arena() );
+        CHECK( pModel->get_arena()->num_objects() > 0 );
+
+        DocModel* pModelCopy = doc.create_model_copy();
+        ImoDocument* pImoCopy = pModelCopy->get_im_root();
+        ImoObj* pScoreCopy = pImoCopy->get_content_item(0);
+        CHECK( ImArena::get_arena_for(pImoCopy) == pModelCopy->get_arena() );
+        CHECK( ImArena::get_arena_for(pScoreCopy) == pModelCopy->get_arena() );
+
+        delete pModelCopy;
+    }
+
+    TEST_FIXTURE(DocModelTestFixture, arena_02)
+    {
+        //@02. The arena is not released while some object allocated in it exists
+
+        ImoObj* pImo = nullptr;
+        ImArena* pArena = nullptr;
+        {
+            Document doc(m_libraryScope);
+            doc.create_empty();
+            pArena = doc.get_doc_model()->get_arena();
+            pImo = ImFactory::inject(k_imo_beam_dto, &doc);
+            CHECK( ImArena::get_arena_for(pImo) == pArena );
+        }
+
+        CHECK( pArena->num_objects() == 1 );
+        delete pImo;
+    }
+#endif
+
 //    TEST_FIXTURE(DocModelTestFixture, clone_999)
 //    {
 //        //@999. benchmarks and measurements
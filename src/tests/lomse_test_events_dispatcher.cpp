@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include <UnitTest++.h>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "lomse_config.h"
+
+//classes related to these tests
+#include "lomse_events_dispatcher.h"
+#include "lomse_events.h"
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+
+//---------------------------------------------------------------------------------------
+//Helper, to create observers and record the notified events
+class MyDispatcherObserver : public Observer
+{
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_received;
+    std::condition_variable m_released;
+    bool m_fBlocked = false;
+    std::vector<SpEventInfo> m_events;
+    std::chrono::steady_clock::time_point m_lastTime;
+
+public:
+    MyDispatcherObserver()
+        : Observer(nullptr)
+    {
+        add_handler(k_tracking_event, this, my_on_event_wrapper);
+        add_handler(k_end_of_playback_event, this, my_on_event_wrapper);
+    }
+
+    static void my_on_event_wrapper(void* pThis, SpEventInfo pEvent)
+    {
+        static_cast<MyDispatcherObserver*>(pThis)->my_on_event(pEvent);
+    }
+
+    void my_on_event(SpEventInfo pEvent)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_lastTime = std::chrono::steady_clock::now();
+        m_events.push_back(pEvent);
+        m_received.notify_all();
+        m_released.wait(lock, [this]{ return !m_fBlocked; });
+    }
+
+    void block()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_fBlocked = true;
+    }
+
+    void release()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_fBlocked = false;
+        }
+        m_released.notify_all();
+    }
+
+    bool wait_for_events(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_received.wait_for(lock, std::chrono::seconds(2),
+                                   [this, num]{ return m_events.size() >= num; });
+    }
+
+    size_t num_events()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_events.size();
+    }
+
+    SpEventInfo get_event(size_t i)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_events[i];
+    }
+
+    std::chrono::steady_clock::time_point last_time()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_lastTime;
+    }
+};
+
+//---------------------------------------------------------------------------------------
+class EventsDispatcherTestFixture
+{
+public:
+
+    EventsDispatcherTestFixture()     //SetUp fixture
+    {
+    }
+
+    ~EventsDispatcherTestFixture()    //TearDown fixture
+    {
+    }
+
+    SpEventVisualTracking create_tracking_event(ImoId id)
+    {
+        SpEventVisualTracking pEvent(
+            LOMSE_NEW EventVisualTracking(WpInteractor(), 10L) );
+        pEvent->add_item(EventVisualTracking::k_highlight_on, id);
+        return pEvent;
+    }
+};
+
+
+SUITE(EventsDispatcherTest)
+{
+
+    TEST_FIXTURE(EventsDispatcherTestFixture, dispatcher_01)
+    {
+        //@01. posted event is delivered to the observer
+
+        EventsDispatcher dispatcher;
+        dispatcher.start_events_loop();
+        MyDispatcherObserver observer;
+
+        dispatcher.post_event(&observer, create_tracking_event(20L));
+
+        CHECK( observer.wait_for_events(1) == true );
+        CHECK( observer.num_events() == 1 );
+        dispatcher.stop_events_loop();
+    }
+
+#if (LOMSE_DIRECT_INVOCATION == 0)
+
+    //the events thread is only used when the library is built with
+    //LOMSE_DIRECT_INVOCATION=OFF. Otherwise observers are invoked from post_event()
+
+    TEST_FIXTURE(EventsDispatcherTestFixture, dispatcher_02)
+    {
+        //@02. latency between posting and delivery. The events thread is not
+        //@    polling, so delivery must be immediate
+
+        EventsDispatcher dispatcher;
+        dispatcher.start_events_loop();
+        MyDispatcherObserver observer;
+
+        const int numEvents = 100;
+        long long totalDelay = 0;
+        long long maxDelay = 0;
+        for (int i=0; i < numEvents; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            auto start = std::chrono::steady_clock::now();
+            dispatcher.post_event(&observer, create_tracking_event(20L + i));
+            observer.wait_for_events(size_t(i + 1));
+            long long delay = std::chrono::duration_cast<std::chrono::microseconds>(
+                                    observer.last_time() - start).count();
+            totalDelay += delay;
+            maxDelay = max(maxDelay, delay);
+        }
+//        cout << "dispatcher_02: mean latency " << totalDelay / numEvents
+//             << " us, max latency " << maxDelay << " us" << endl;
+
+        CHECK( observer.num_events() == size_t(numEvents) );
+        CHECK( totalDelay / numEvents < 1000LL );      //less than 1 ms
+        dispatcher.stop_events_loop();
+    }
+
+    TEST_FIXTURE(EventsDispatcherTestFixture, dispatcher_03)
+    {
+        //@03. pending visual tracking events for the same observer are merged
+
+        EventsDispatcher dispatcher;
+        dispatcher.start_events_loop();
+        MyDispatcherObserver observer;
+        observer.block();
+
+        dispatcher.post_event(&observer, create_tracking_event(20L));
+        CHECK( observer.wait_for_events(1) == true );
+        //while the observer is busy, new events are queued
+        dispatcher.post_event(&observer, create_tracking_event(21L));
+        dispatcher.post_event(&observer, create_tracking_event(22L));
+        dispatcher.post_event(&observer, create_tracking_event(23L));
+        observer.release();
+
+        CHECK( observer.wait_for_events(2) == true );
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK( observer.num_events() == 2 );
+        SpEventVisualTracking pEv(
+            static_pointer_cast<EventVisualTracking>(observer.get_event(1)) );
+        CHECK( pEv->get_num_items() == 3 );
+        CHECK( pEv->get_items().back().second == 23L );
+        dispatcher.stop_events_loop();
+    }
+
+    TEST_FIXTURE(EventsDispatcherTestFixture, dispatcher_04)
+    {
+        //@04. other events are not merged and order is preserved
+
+        EventsDispatcher dispatcher;
+        dispatcher.start_events_loop();
+        MyDispatcherObserver observer;
+        observer.block();
+
+        dispatcher.post_event(&observer, create_tracking_event(20L));
+        CHECK( observer.wait_for_events(1) == true );
+        dispatcher.post_event(&observer, create_tracking_event(21L));
+        SpEventInfo pEnd( LOMSE_NEW EventEndOfPlayback(k_end_of_playback_event,
+                                                       WpInteractor(), nullptr, nullptr) );
+        dispatcher.post_event(&observer, pEnd);
+        dispatcher.post_event(&observer, create_tracking_event(22L));
+        observer.release();
+
+        CHECK( observer.wait_for_events(4) == true );
+        CHECK( observer.num_events() == 4 );
+        CHECK( observer.get_event(2)->get_event_type() == k_end_of_playback_event );
+        dispatcher.stop_events_loop();
+    }
+#endif
+
+}
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include <UnitTest++.h>
+#include <sstream>
+#include "lomse_config.h"
+
+//classes related to these tests
+#include "lomse_font_cache_manager.h"
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+
+//---------------------------------------------------------------------------------------
+class FontCachePoolTestFixture
+{
+public:
+
+    FontCachePoolTestFixture()     //SetUp fixture
+    {
+    }
+
+    ~FontCachePoolTestFixture()    //TearDown fixture
+    {
+    }
+
+    glyph_cache* add_glyph(font_cache_pool& pool, unsigned code, unsigned size=100)
+    {
+        rect_i bounds(0, 0, 10, 10);
+        return pool.cache_glyph(code, code, size, glyph_data_gray8, bounds, 10.0, 0.0);
+    }
+};
+
+
+SUITE(FontCachePoolTest)
+{
+
+    TEST_FIXTURE(FontCachePoolTestFixture, font_cache_pool_01)
+    {
+        //@01. glyphs are kept when returning to a previous font
+
+        font_cache_pool pool;
+        pool.font("music,24");
+        add_glyph(pool, 0xE0A4);
+        pool.font("music,36");
+        CHECK( pool.find_glyph(0xE0A4) == nullptr );
+        pool.font("music,24");
+
+        CHECK( pool.find_glyph(0xE0A4) != nullptr );
+        CHECK( pool.num_fonts() == 2 );
+    }
+
+    TEST_FIXTURE(FontCachePoolTestFixture, font_cache_pool_02)
+    {
+        //@02. when full, the least recently used font is discarded
+
+        font_cache_pool pool(2);
+        pool.font("music,24");
+        add_glyph(pool, 0xE0A4);
+        pool.font("music,36");
+        pool.font("music,24");
+        pool.font("music,48");
+
+        CHECK( pool.num_fonts() == 2 );
+        CHECK( pool.find_font("music,36") == -1 );
+        CHECK( pool.find_font("music,24") != -1 );
+        pool.font("music,24");
+        CHECK( pool.find_glyph(0xE0A4) != nullptr );
+    }
+
+    TEST_FIXTURE(FontCachePoolTestFixture, font_cache_pool_03)
+    {
+        //@03. memory budget exceeded: least recently used fonts are discarded
+
+        unsigned cacheSize = font_cache::block_size;
+        font_cache_pool pool(256, 3 * cacheSize);
+        pool.font("music,24");
+        add_glyph(pool, 0xE0A4);
+        pool.font("music,36");
+        add_glyph(pool, 0xE0A4);
+        pool.font("music,24");
+        pool.font("music,48");
+        CHECK( pool.num_fonts() == 2 );
+        CHECK( pool.find_font("music,36") == -1 );
+        CHECK( pool.memory_used() <= 3 * cacheSize );
+    }
+
+    TEST_FIXTURE(FontCachePoolTestFixture, font_cache_pool_04)
+    {
+        //@04. current font is never discarded
+
+        font_cache_pool pool(256, 100);
+        pool.font("music,24");
+        add_glyph(pool, 0xE0A4, 1000);
+        pool.font("music,36");
+        add_glyph(pool, 0xE0A4, 1000);
+
+        CHECK( pool.num_fonts() == 1 );
+        CHECK( pool.find_glyph(0xE0A4) != nullptr );
+    }
+
+}
@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include <UnitTest++.h>
+#include <sstream>
+#include "lomse_config.h"
+
+//classes related to these tests
+#include "lomse_injectors.h"
+#include "lomse_font_storage.h"
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+
+//---------------------------------------------------------------------------------------
+//helper, to access protected members
+class MyFontStorage : public FontStorage
+{
+public:
+    MyFontStorage(LibraryScope* pLibScope) : FontStorage(pLibScope) {}
+
+    bool my_is_last_request_current() {
+        return m_lastRequest.fontPathsRevision == m_pLibScope->get_font_paths_revision();
+    }
+    bool my_is_last_request(bool fBold, bool fItalic) {
+        return m_lastRequest.fBold == fBold && m_lastRequest.fItalic == fItalic;
+    }
+};
+
+//---------------------------------------------------------------------------------------
+class FontStorageTestFixture
+{
+public:
+    LibraryScope m_libraryScope;
+
+    FontStorageTestFixture()     //SetUp fixture
+        : m_libraryScope(cout)
+    {
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+    }
+
+    ~FontStorageTestFixture()    //TearDown fixture
+    {
+    }
+};
+
+
+SUITE(FontStorageTest)
+{
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_01)
+    {
+        //@01. selecting again the current font does nothing
+
+        FontStorage storage(&m_libraryScope);
+        CHECK( storage.select_font("en", "", "Liberation serif", 12.0) == false );
+        int changes = storage.get_num_font_changes();
+
+        CHECK( storage.select_font("en", "", "Liberation serif", 12.0) == false );
+
+        CHECK( storage.get_num_font_changes() == changes );
+        CHECK( storage.is_font_valid() == true );
+    }
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_02)
+    {
+        //@02. changing the size selects the font again
+
+        FontStorage storage(&m_libraryScope);
+        storage.select_font("en", "", "Liberation serif", 12.0);
+        int changes = storage.get_num_font_changes();
+
+        storage.select_font("en", "", "Liberation serif", 14.0);
+
+        CHECK( storage.get_num_font_changes() == changes + 1 );
+        CHECK( storage.get_font_height_in_points() == 14.0 );
+    }
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_03)
+    {
+        //@03. changing the font file selects the font again
+
+        FontStorage storage(&m_libraryScope);
+        storage.select_font("en", "", "Liberation serif", 12.0);
+        string file = storage.get_font_file();
+        int changes = storage.get_num_font_changes();
+
+        storage.select_font("en", "", "Liberation sans", 12.0);
+
+        CHECK( storage.get_num_font_changes() == changes + 1 );
+        CHECK( storage.get_font_file() != file );
+    }
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_04)
+    {
+        //@04. changing bold or italic searches the font again
+
+        MyFontStorage storage(&m_libraryScope);
+        storage.select_font("en", "", "Liberation serif", 12.0);
+        string file = storage.get_font_file();
+        int changes = storage.get_num_font_changes();
+
+        storage.select_font("en", "", "Liberation serif", 12.0, true, false);
+        CHECK( storage.my_is_last_request(true, false) == true );
+        CHECK( storage.get_num_font_changes() == changes + 1 );
+        CHECK( storage.get_font_file() != file );
+
+        storage.select_font("en", "", "Liberation serif", 12.0, false, true);
+        CHECK( storage.my_is_last_request(false, true) == true );
+    }
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_05)
+    {
+        //@05. changing the cache type selects the font again
+
+        FontStorage storage(&m_libraryScope);
+        storage.select_raster_font("en", "", "Liberation serif", 12.0);
+        int changes = storage.get_num_font_changes();
+
+        storage.select_vector_font("en", "", "Liberation serif", 12.0);
+
+        CHECK( storage.get_num_font_changes() == changes + 1 );
+        CHECK( storage.get_font_cache_type() == k_vector_font_cache );
+    }
+
+    TEST_FIXTURE(FontStorageTestFixture, font_storage_06)
+    {
+        //@06. the last request is discarded when the font paths change
+
+        MyFontStorage storage(&m_libraryScope);
+        storage.select_font("en", "", "Liberation serif", 12.0);
+        CHECK( storage.my_is_last_request_current() == true );
+
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+        CHECK( storage.my_is_last_request_current() == false );
+
+        storage.select_font("en", "", "Liberation serif", 12.0);
+        CHECK( storage.my_is_last_request_current() == true );
+    }
+
+}
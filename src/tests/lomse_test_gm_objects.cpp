@@ -21,6 +21,7 @@
 #include "lomse_internal_model.h"
 #include "lomse_shape_staff.h"
 #include "lomse_im_factory.h"
+#include "lomse_selections.h"
 #include "private/lomse_document_p.h"
 
 using namespace UnitTest;
@@ -288,6 +289,174 @@ SUITE(GmoTest)
         CHECK( pDP->get_graphic_model() == &gm );
     }
 
+    TEST_FIXTURE(GmoTestFixture, Box_DrawingBoundsIncludeContent)
+    {
+        Document doc(m_libraryScope);
+        GmoBoxDocPage page(nullptr);
+        page.set_origin(0.0f, 0.0f);
+        page.set_width(1000.0f);
+        page.set_height(1000.0f);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        pBox->set_origin(100.0f, 100.0f);
+        pBox->set_width(200.0f);
+        pBox->set_height(200.0f);
+        page.add_child_box(pBox);
+        ImoStaffInfo* pInfo = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        GmoShapeStaff* pShape = LOMSE_NEW GmoShapeStaff(pInfo, 0, pInfo, 0, 500.0f, Color(0,0,0));
+        pBox->add_shape(pShape, 0);
+        pShape->set_origin(2000.0f, 3000.0f);
+
+        URect bounds = page.get_drawing_bounds();
+        CHECK( bounds.left() == 0.0f );
+        CHECK( bounds.top() == 0.0f );
+        CHECK( bounds.right() == pShape->get_right() );
+        CHECK( bounds.bottom() == pShape->get_bottom() );
+        delete pInfo;
+    }
+
+    TEST_FIXTURE(GmoTestFixture, Box_DrawingBoundsUpdatedWhenContentMoves)
+    {
+        Document doc(m_libraryScope);
+        GmoBoxDocPage page(nullptr);
+        page.set_width(1000.0f);
+        page.set_height(1000.0f);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        page.add_child_box(pBox);
+        ImoStaffInfo* pInfo = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        GmoShapeStaff* pShape = LOMSE_NEW GmoShapeStaff(pInfo, 0, pInfo, 0, 500.0f, Color(0,0,0));
+        pBox->add_shape(pShape, 0);
+        pShape->set_origin(100.0f, 100.0f);
+        URect bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == 1000.0f );
+        CHECK( bounds.bottom() == 1000.0f );
+
+        pShape->set_origin(5000.0f, 6000.0f);
+        bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == pShape->get_right() );
+        CHECK( bounds.bottom() == pShape->get_bottom() );
+
+        pBox->shift_origin_and_content(USize(0.0f, 2000.0f));
+        bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == pShape->get_right() );
+        CHECK( bounds.bottom() == pShape->get_bottom() );
+        CHECK( pShape->get_top() == 8000.0f );
+        delete pInfo;
+    }
+
+    TEST_FIXTURE(GmoTestFixture, Box_DrawingBoundsUpdatedWhenSizeChanges)
+    {
+        GmoBoxDocPage page(nullptr);
+        page.set_width(1000.0f);
+        page.set_height(1000.0f);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        page.add_child_box(pBox);
+        pBox->set_width(500.0f);
+        pBox->set_height(500.0f);
+        URect bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == 1000.0f );
+        CHECK( bounds.bottom() == 1000.0f );
+
+        pBox->set_width(3000.0f);
+        bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == 3000.0f );
+        CHECK( bounds.bottom() == 1000.0f );
+
+        pBox->set_height(4000.0f);
+        bounds = page.get_drawing_bounds();
+        CHECK( bounds.right() == 3000.0f );
+        CHECK( bounds.bottom() == 4000.0f );
+    }
+
+    // GmoBoxDocPage spatial index -------------------------------------------------------
+
+    TEST_FIXTURE(GmoTestFixture, DocPage_FindShapeAt)
+    {
+        Document doc(m_libraryScope);
+        GmoBoxDocPage page(nullptr);
+        page.set_width(10000.0f);
+        page.set_height(10000.0f);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        page.add_child_box(pBox);
+        ImoStaffInfo* pInfo = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        GmoShapeStaff* pShape0 = LOMSE_NEW GmoShapeStaff(pInfo, 0, pInfo, 0, 1000.0f, Color(0,0,0));
+        pShape0->set_origin(1000.0f, 1000.0f);
+        pBox->add_shape(pShape0, 2);
+        GmoShapeStaff* pShape1 = LOMSE_NEW GmoShapeStaff(pInfo, 1, pInfo, 0, 1000.0f, Color(0,0,0));
+        pShape1->set_origin(1500.0f, 1000.0f);
+        pBox->add_shape(pShape1, 1);
+        pBox->add_shapes_to_tables();
+
+        CHECK( page.find_shape_at(1200.0f, 1010.0f) == pShape0 );
+        CHECK( page.find_shape_at(1700.0f, 1010.0f) == pShape0 );     //upper layer
+        CHECK( page.find_shape_at(2200.0f, 1010.0f) == pShape1 );
+        CHECK( page.find_shape_at(8000.0f, 8000.0f) == nullptr );
+        CHECK( page.find_shape_at(-100.0f, 1010.0f) == nullptr );
+
+        pShape1->set_origin(7000.0f, 7000.0f);
+        CHECK( page.find_shape_at(2200.0f, 1010.0f) == nullptr );
+        CHECK( page.find_shape_at(7200.0f, 7010.0f) == pShape1 );
+        delete pInfo;
+    }
+
+    TEST_FIXTURE(GmoTestFixture, DocPage_FindShapeForObject)
+    {
+        Document doc(m_libraryScope);
+        GmoBoxDocPage page(nullptr);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        page.add_child_box(pBox);
+        ImoStaffInfo* pInfo = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        ImoClef* pClef = static_cast<ImoClef*>(ImFactory::inject(k_imo_clef, &doc));
+        GmoShapeStaff* pShape0 = LOMSE_NEW GmoShapeStaff(pClef, 0, pInfo, 0, 100.0f, Color(0,0,0));
+        pBox->add_shape(pShape0, 2);
+        GmoShapeStaff* pShape1 = LOMSE_NEW GmoShapeStaff(pClef, 1, pInfo, 0, 100.0f, Color(0,0,0));
+        pBox->add_shape(pShape1, 1);
+        pBox->add_shapes_to_tables();
+
+        CHECK( page.find_shape_for_object(pClef) == pShape1 );     //lower layer first
+        delete pInfo;
+        delete pClef;
+    }
+
+    TEST_FIXTURE(GmoTestFixture, DocPage_SelectObjectsInRectangle)
+    {
+        Document doc(m_libraryScope);
+        GmoBoxDocPage page(nullptr);
+        page.set_width(10000.0f);
+        page.set_height(10000.0f);
+        GmoBoxSystem* pBox = LOMSE_NEW GmoBoxSystem(nullptr);
+        page.add_child_box(pBox);
+        ImoStaffInfo* pInfo = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        ImoStaffInfo* pInfo0 = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        ImoStaffInfo* pInfo1 = static_cast<ImoStaffInfo*>(
+                                    ImFactory::inject(k_imo_staff_info, &doc));
+        GmoShapeStaff* pShape0 = LOMSE_NEW GmoShapeStaff(pInfo0, 0, pInfo, 0, 100.0f, Color(0,0,0));
+        pShape0->set_origin(1000.0f, 1000.0f);
+        pBox->add_shape(pShape0, 1);
+        GmoShapeStaff* pShape1 = LOMSE_NEW GmoShapeStaff(pInfo1, 0, pInfo, 0, 100.0f, Color(0,0,0));
+        pShape1->set_origin(6000.0f, 6000.0f);
+        pBox->add_shape(pShape1, 1);
+        pBox->add_shapes_to_tables();
+
+        SelectionSet selection(&doc);
+        page.select_objects_in_rectangle(&selection, URect(500.0f, 500.0f, 3000.0f, 3000.0f));
+        CHECK( selection.num_selected() == 1 );
+        CHECK( selection.contains(pInfo0) );
+
+        selection.clear();
+        page.select_objects_in_rectangle(&selection, URect(500.0f, 500.0f, 8000.0f, 8000.0f));
+        CHECK( selection.num_selected() == 2 );
+        CHECK( selection.contains(pInfo1) );
+        delete pInfo;
+        delete pInfo0;
+        delete pInfo1;
+    }
+
 };
 
 
@@ -0,0 +1,285 @@
+//---------------------------------------------------------------------------------------
+// This file is part of the Lomse library.
+// Copyright (c) 2010-present, Lomse Developers
+//
+// Licensed under the MIT license.
+//
+// See LICENSE and NOTICE.md files in the root directory of this source tree.
+//---------------------------------------------------------------------------------------
+
+#include <UnitTest++.h>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include "lomse_build_options.h"
+
+//classes related to these tests
+#include "lomse_injectors.h"
+#include "lomse_midi_exporter.h"
+#include "lomse_internal_model.h"
+#include "private/lomse_document_p.h"
+
+
+using namespace UnitTest;
+using namespace std;
+using namespace lomse;
+
+
+//=======================================================================================
+// test for MidiExporter
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+//helper: a decoded event of a MIDI file track
+struct MidiTestEvent
+{
+    long time;
+    int status;
+    int data1;
+    int data2;
+};
+
+//---------------------------------------------------------------------------------------
+class MidiExporterTestFixture
+{
+public:
+    LibraryScope m_libraryScope;
+    std::string m_scores_path;
+    int m_format;
+    int m_division;
+    std::vector< std::vector<MidiTestEvent> > m_tracks;
+
+    MidiExporterTestFixture()     //SetUp fixture
+        : m_libraryScope(cout)
+        , m_scores_path(TESTLIB_SCORES_PATH)
+        , m_format(-1)
+        , m_division(0)
+    {
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+    }
+
+    ~MidiExporterTestFixture()    //TearDown fixture
+    {
+    }
+
+    long read_int(const string& data, size_t& i, int numBytes)
+    {
+        long value = 0;
+        for (int k=0; k < numBytes; ++k)
+            value = (value << 8) | (unsigned char)data[i++];
+        return value;
+    }
+
+    long read_var_length(const string& data, size_t& i)
+    {
+        long value = 0;
+        unsigned char c;
+        do
+        {
+            c = (unsigned char)data[i++];
+            value = (value << 7) | (c & 0x7F);
+        } while (c & 0x80);
+        return value;
+    }
+
+    bool decode(const string& data)
+    {
+        //decodes the MIDI file. For meta events, data1 is the meta type
+        m_tracks.clear();
+        if (data.size() < 14 || data.substr(0, 4) != "MThd")
+            return false;
+        size_t i = 8;
+        m_format = int(read_int(data, i, 2));
+        int numTracks = int(read_int(data, i, 2));
+        m_division = int(read_int(data, i, 2));
+        for (int t=0; t < numTracks; ++t)
+        {
+            if (data.substr(i, 4) != "MTrk")
+                return false;
+            i += 4;
+            size_t end = size_t(read_int(data, i, 4)) + i;
+            m_tracks.resize(m_tracks.size() + 1);
+            long time = 0;
+            while (i < end)
+            {
+                time += read_var_length(data, i);
+                MidiTestEvent ev = {time, (unsigned char)data[i++], 0, 0};
+                if (ev.status == 0xFF)
+                {
+                    ev.data1 = (unsigned char)data[i++];
+                    i += size_t(read_var_length(data, i));
+                }
+                else
+                {
+                    ev.data1 = (unsigned char)data[i++];
+                    if ((ev.status & 0xF0) != 0xC0)
+                        ev.data2 = (unsigned char)data[i++];
+                }
+                m_tracks.back().push_back(ev);
+            }
+            if (i != end)
+                return false;
+        }
+        return i == data.size();
+    }
+
+    int count_events(int track, int status)
+    {
+        int count = 0;
+        for (auto& ev : m_tracks[track])
+        {
+            if (ev.status == status)
+                ++count;
+        }
+        return count;
+    }
+
+};
+
+SUITE(MidiExporterTest)
+{
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_01)
+    {
+        //@01. header and tracks: conductor + one track per channel
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 2 4)(n c4 q)(n e4 q)(barline) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        string data = exporter.get_midi(pScore);
+
+        CHECK( decode(data) == true );
+        CHECK( m_format == 1 );
+        CHECK( m_division == MidiExporter::k_division );
+        CHECK( m_tracks.size() == 2 );
+        CHECK( count_events(1, 0x90) == 2 );
+        CHECK( count_events(1, 0x80) == 2 );
+        CHECK( count_events(1, 0xC0) == 1 );
+        //last event is end of track, at the end of the score
+        CHECK( m_tracks[1].back().status == 0xFF );
+        CHECK( m_tracks[1].back().data1 == 0x2F );
+        CHECK( m_tracks[1].back().time == 128L );
+    }
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_02)
+    {
+        //@02. conductor track: tempo and time signature
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 2 4)(n c4 q)(n e4 q)(barline) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        exporter.set_tempo(120);
+        string data = exporter.get_midi(pScore);
+
+        CHECK( decode(data) == true );
+        CHECK( m_tracks[0].size() == 3 );
+        CHECK( m_tracks[0][0].status == 0xFF );
+        CHECK( m_tracks[0][0].data1 == 0x51 );
+        CHECK( m_tracks[0][1].status == 0xFF );
+        CHECK( m_tracks[0][1].data1 == 0x58 );
+        //tempo value: 500000 microseconds per quarter note
+        CHECK( data.find(string("\xFF\x51\x03\x07\xA1\x20", 6)) != string::npos );
+        //time signature 2/4
+        CHECK( data.find(string("\xFF\x58\x04\x02\x02", 5)) != string::npos );
+    }
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_03)
+    {
+        //@03. repetitions are expanded
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 2 4)(n c4 q)(n e4 q)(barline)(n g4 q)(n c5 q)"
+            "(barline endRepetition) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        string data = exporter.get_midi(pScore);
+
+        CHECK( decode(data) == true );
+        CHECK( count_events(1, 0x90) == 8 );
+        CHECK( m_tracks[1].back().time == 512L );
+        //second time, first note starts after the first two measures
+        CHECK( m_tracks[1][9].status == 0x90 );
+        CHECK( m_tracks[1][9].data1 == 60 );
+        CHECK( m_tracks[1][9].time == 256L );
+    }
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_04)
+    {
+        //@04. metronome track: a click per beat, first beat accented
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 2 4)(n c4 q)(n e4 q)(barline)(n g4 q)(n c5 q)(barline) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        exporter.set_metronome(true);
+        string data = exporter.get_midi(pScore);
+
+        CHECK( decode(data) == true );
+        CHECK( m_tracks.size() == 3 );
+        CHECK( count_events(2, 0x99) == 4 );
+        CHECK( m_tracks[2][2].time == 0L );
+        CHECK( m_tracks[2][2].data1 == 60 );
+        CHECK( m_tracks[2][4].time == 64L );
+        CHECK( m_tracks[2][4].data1 == 77 );
+        CHECK( m_tracks[2][6].time == 128L );
+        CHECK( m_tracks[2][6].data1 == 60 );
+    }
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_05)
+    {
+        //@05. anacrusis: metronome clicks aligned to measures
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 3 4)(n g4 q)(barline)(n c4 q)(n e4 q)(n g4 q)(barline) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        exporter.set_metronome(true);
+        string data = exporter.get_midi(pScore);
+
+        CHECK( decode(data) == true );
+        CHECK( count_events(2, 0x99) == 4 );
+        CHECK( m_tracks[2][2].data1 == 77 );    //anacrusis beat
+        CHECK( m_tracks[2][4].time == 64L );
+        CHECK( m_tracks[2][4].data1 == 60 );    //first beat of first full measure
+    }
+
+    TEST_FIXTURE(MidiExporterTestFixture, midi_exporter_06)
+    {
+        //@06. save to file
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)"
+            "(time 2 4)(n c4 q)(n e4 q)(barline) ))))) ");
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+
+        MidiExporter exporter(m_libraryScope);
+        string filename = m_scores_path + "../z_test_midi_exporter.mid";
+        CHECK( exporter.save_midi_file(pScore, filename) == true );
+
+        ifstream file(filename, ios::in | ios::binary);
+        stringstream content;
+        content << file.rdbuf();
+        CHECK( content.str() == exporter.get_midi(pScore) );
+        file.close();
+        std::remove(filename.c_str());
+    }
+
+};
@@ -178,11 +178,11 @@ SUITE(MidiTableTest)
         table.my_program_sounds_for_instruments();
 
         CHECK( check_num_events(table.num_events(), 1) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        SoundEvent* ev = events.front();
-        CHECK( ev->Channel == 0 );
-        CHECK( ev->Instrument == 0 );
-        CHECK( ev->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        SoundEvent& ev = events.front();
+        CHECK( ev.Channel == 0 );
+        CHECK( ev.Instrument == 0 );
+        CHECK( ev.EventType == SoundEvent::k_prog_instr );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, ProgramSoundsMidiInfo)
@@ -197,11 +197,11 @@ SUITE(MidiTableTest)
         table.my_program_sounds_for_instruments();
 
         CHECK( check_num_events(table.num_events(), 1) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        SoundEvent* ev = events.front();
-        CHECK( ev->Channel == 0 );
-        CHECK( ev->Instrument == 2 );
-        CHECK( ev->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        SoundEvent& ev = events.front();
+        CHECK( ev.Channel == 0 );
+        CHECK( ev.Instrument == 2 );
+        CHECK( ev.EventType == SoundEvent::k_prog_instr );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CreateEvents_OneNote)
@@ -217,13 +217,13 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 3) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
+        CHECK( it->EventType == SoundEvent::k_note_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CreateEvents_OneRest)
@@ -239,13 +239,13 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 3) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_on );
+        CHECK( it->EventType == SoundEvent::k_visual_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_off );
+        CHECK( it->EventType == SoundEvent::k_visual_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CreateEvents_RestNoVisible)
@@ -261,13 +261,13 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 3) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
+        CHECK( it->EventType == SoundEvent::k_note_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CreateEvents_TwoNotesTied)
@@ -283,17 +283,17 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 5) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
+        CHECK( it->EventType == SoundEvent::k_note_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_off );
+        CHECK( it->EventType == SoundEvent::k_visual_off );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_on );
+        CHECK( it->EventType == SoundEvent::k_visual_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, midi_table_014)
@@ -318,13 +318,13 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 3) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
+        CHECK( it->EventType == SoundEvent::k_note_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, BarlineIncrementsMeasureCount)
@@ -339,19 +339,19 @@ SUITE(MidiTableTest)
         table.my_program_sounds_for_instruments();
         table.my_create_events();
 
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
-        CHECK( (*it)->Measure == 1 );
+        CHECK( it->EventType == SoundEvent::k_note_on );
+        CHECK( it->Measure == 1 );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
-        CHECK( (*it)->Measure == 2 );
+        CHECK( it->EventType == SoundEvent::k_note_on );
+        CHECK( it->Measure == 2 );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
+        CHECK( it->EventType == SoundEvent::k_note_off );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, TimeSignatureAddsRythmChange)
@@ -367,16 +367,16 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 2) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_rhythm_change );
-        CHECK( (*it)->TopNumber == 2 );
-        CHECK( (*it)->BeatDuration == 64 );
-        CHECK( (*it)->NumPulses == 2 );
-        //cout << ", NumPulses = " << (*it)->NumPulses
-        //     << ", TopNumber = " << (*it)->TopNumber << endl;
+        CHECK( it->EventType == SoundEvent::k_rhythm_change );
+        CHECK( it->TopNumber == 2 );
+        CHECK( it->BeatDuration == 64 );
+        CHECK( it->NumPulses == 2 );
+        //cout << ", NumPulses = " << it->NumPulses
+        //     << ", TopNumber = " << it->TopNumber << endl;
     }
 
     TEST_FIXTURE(MidiTableTestFixture, TimeSignatureInfoOk)
@@ -392,16 +392,16 @@ SUITE(MidiTableTest)
         table.my_create_events();
 
         CHECK( check_num_events(table.num_events(), 2) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_rhythm_change );
-        CHECK( (*it)->TopNumber == 6 );
-        CHECK( (*it)->BeatDuration == 32 );
-        CHECK( (*it)->NumPulses == 2 );
-        //cout << ", NumPulses = " << (*it)->NumPulses
-        //     << ", TopNumber = " << (*it)->TopNumber << endl;
+        CHECK( it->EventType == SoundEvent::k_rhythm_change );
+        CHECK( it->TopNumber == 6 );
+        CHECK( it->BeatDuration == 32 );
+        CHECK( it->NumPulses == 2 );
+        //cout << ", NumPulses = " << it->NumPulses
+        //     << ", TopNumber = " << it->TopNumber << endl;
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CloseTableAddsEvent)
@@ -416,10 +416,10 @@ SUITE(MidiTableTest)
         table.my_close_table();
 
         CHECK( check_num_events(table.num_events(), 1) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_end_of_score );
-        CHECK( (*it)->DeltaTime == 0.0f );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_end_of_score );
+        CHECK( it->DeltaTime == 0.0f );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, CloseTableFinalTime)
@@ -436,16 +436,16 @@ SUITE(MidiTableTest)
         table.my_close_table();
 
         CHECK( check_num_events(table.num_events(), 4) );
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_on );
+        CHECK( it->EventType == SoundEvent::k_visual_on );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_visual_off );
+        CHECK( it->EventType == SoundEvent::k_visual_off );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_end_of_score );
-        CHECK( (*it)->DeltaTime == 64.0f );
+        CHECK( it->EventType == SoundEvent::k_end_of_score );
+        CHECK( it->DeltaTime == 64.0f );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, EventsSorted)
@@ -462,24 +462,67 @@ SUITE(MidiTableTest)
         table.my_close_table();
         table.my_sort_by_time();
 
-        std::vector<SoundEvent*>& events = table.get_events();
-        std::vector<SoundEvent*>::iterator it = events.begin();
-        CHECK( (*it)->EventType == SoundEvent::k_prog_instr );
+        std::vector<SoundEvent>& events = table.get_events();
+        std::vector<SoundEvent>::iterator it = events.begin();
+        CHECK( it->EventType == SoundEvent::k_prog_instr );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
-        CHECK( (*it)->DeltaTime == 0.0f );
+        CHECK( it->EventType == SoundEvent::k_note_on );
+        CHECK( it->DeltaTime == 0.0f );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_on );
-        CHECK( (*it)->DeltaTime == 0.0f );
+        CHECK( it->EventType == SoundEvent::k_note_on );
+        CHECK( it->DeltaTime == 0.0f );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
-        CHECK( (*it)->DeltaTime == 64.0f );
+        CHECK( it->EventType == SoundEvent::k_note_off );
+        CHECK( it->DeltaTime == 64.0f );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_note_off );
-        CHECK( (*it)->DeltaTime == 64.0f );
+        CHECK( it->EventType == SoundEvent::k_note_off );
+        CHECK( it->DeltaTime == 64.0f );
         ++it;
-        CHECK( (*it)->EventType == SoundEvent::k_end_of_score );
-        CHECK( (*it)->DeltaTime == 64.0f );
+        CHECK( it->EventType == SoundEvent::k_end_of_score );
+        CHECK( it->DeltaTime == 64.0f );
+    }
+
+    TEST_FIXTURE(MidiTableTestFixture, EventsSorted_201)
+    {
+        //@201. Many instruments, long notes mixed with short notes. Events are sorted
+        //      by time and, for the same time, by event type
+
+        stringstream src;
+        src << "(lenmusdoc (vers 0.0) (content (score (vers 1.6) ";
+        for (int iInstr=0; iInstr < 4; ++iInstr)
+        {
+            src << "(instrument (musicData (clef G)(time 4 4)";
+            for (int iMeasure=0; iMeasure < 20; ++iMeasure)
+            {
+                if (iInstr == 0)
+                    src << "(n c4 w)";
+                else
+                    src << "(n c4 s)(n e5 s)(n f4 e)(n g4 q)(n a4 h)";
+                src << "(barline simple)";
+            }
+            src << "))";
+        }
+        src << ")))";
+
+        Document doc(m_libraryScope);
+        doc.from_string(src.str());
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        MySoundEventsTable table(pScore);
+        table.create_table();
+
+        std::vector<SoundEvent>& events = table.get_events();
+        CHECK( events.back().EventType == SoundEvent::k_end_of_score );
+        bool fSorted = true;
+        for (size_t i=1; i < events.size(); ++i)
+        {
+            if (events[i-1].DeltaTime > events[i].DeltaTime
+                || (events[i-1].DeltaTime == events[i].DeltaTime
+                    && events[i-1].EventType > events[i].EventType) )
+            {
+                fSorted = false;
+            }
+        }
+        CHECK( fSorted );
     }
 
 
@@ -494,15 +537,15 @@ SUITE(MidiTableTest)
         MySoundEventsTable table(pScore);
         table.create_table();
 
-        std::vector<SoundEvent*>& events = table.get_events();
+        std::vector<SoundEvent>& events = table.get_events();
 
         int iEv = table.get_first_event_for_measure(1);
         CHECK( iEv == 1 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_note_on );
+        CHECK( events[iEv].EventType == SoundEvent::k_note_on );
 
         iEv = table.get_last_event();
         CHECK( iEv == 5 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_end_of_score );
+        CHECK( events[iEv].EventType == SoundEvent::k_end_of_score );
 
         CHECK( table.get_num_measures() == 1 );
     }
@@ -516,11 +559,11 @@ SUITE(MidiTableTest)
         MySoundEventsTable table(pScore);
         table.create_table();
 
-        std::vector<SoundEvent*>& events = table.get_events();
+        std::vector<SoundEvent>& events = table.get_events();
 
         int iEv = table.get_first_event_for_measure(2);
         CHECK( iEv == 5 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_end_of_score );
+        CHECK( events[iEv].EventType == SoundEvent::k_end_of_score );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, MeasuresTable_InitialControlMeasure)
@@ -532,11 +575,11 @@ SUITE(MidiTableTest)
         MySoundEventsTable table(pScore);
         table.create_table();
 
-        std::vector<SoundEvent*>& events = table.get_events();
+        std::vector<SoundEvent>& events = table.get_events();
 
         int iEv = table.get_first_event_for_measure(0);
         CHECK( iEv == 0 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_prog_instr );
+        CHECK( events[iEv].EventType == SoundEvent::k_prog_instr );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, MeasuresTable_TwoMeasures)
@@ -548,27 +591,27 @@ SUITE(MidiTableTest)
         MySoundEventsTable table(pScore);
         table.create_table();
 
-        std::vector<SoundEvent*>& events = table.get_events();
+        std::vector<SoundEvent>& events = table.get_events();
 
         int iEv = table.get_first_event_for_measure(0);
         CHECK( iEv == 0 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_prog_instr );
+        CHECK( events[iEv].EventType == SoundEvent::k_prog_instr );
 
         iEv = table.get_first_event_for_measure(1);
         CHECK( iEv == 1 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_note_on );
+        CHECK( events[iEv].EventType == SoundEvent::k_note_on );
 
         iEv = table.get_first_event_for_measure(2);
         CHECK( iEv == 3 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_note_on );
+        CHECK( events[iEv].EventType == SoundEvent::k_note_on );
 
         iEv = table.get_first_event_for_measure(3);
         CHECK( iEv == 5 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_end_of_score );
+        CHECK( events[iEv].EventType == SoundEvent::k_end_of_score );
 
         iEv = table.get_last_event();
         CHECK( iEv == 5 );
-        CHECK( events[iEv]->EventType == SoundEvent::k_end_of_score );
+        CHECK( events[iEv].EventType == SoundEvent::k_end_of_score );
 
         CHECK( table.get_num_measures() == 2 );
     }
@@ -881,22 +924,22 @@ SUITE(MidiTableTest)
 
         CHECK( pTable && check_num_events(pTable->num_events(), 12) );
         CHECK( pTable && pTable->get_anacrusis_missing_time() == 0.0 );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[1]->EventType == SoundEvent::k_note_on );
-        CHECK( events[1]->DeltaTime == 0L );
-        CHECK( events[1]->Volume == 64);
-        CHECK( events[3]->EventType == SoundEvent::k_note_on );
-        CHECK( events[3]->DeltaTime == 64L );
-        CHECK( events[3]->Volume == 64);
-        CHECK( events[5]->EventType == SoundEvent::k_note_on );
-        CHECK( events[5]->DeltaTime == 128L );
-        CHECK( events[5]->Volume == 64);
-        CHECK( events[7]->EventType == SoundEvent::k_note_on );
-        CHECK( events[7]->DeltaTime == 192L );
-        CHECK( events[7]->Volume == 64);
-        CHECK( events[9]->EventType == SoundEvent::k_note_on );
-        CHECK( events[9]->DeltaTime == 256L );
-        CHECK( events[9]->Volume == 64);
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[1].EventType == SoundEvent::k_note_on );
+        CHECK( events[1].DeltaTime == 0L );
+        CHECK( events[1].Volume == 64);
+        CHECK( events[3].EventType == SoundEvent::k_note_on );
+        CHECK( events[3].DeltaTime == 64L );
+        CHECK( events[3].Volume == 64);
+        CHECK( events[5].EventType == SoundEvent::k_note_on );
+        CHECK( events[5].DeltaTime == 128L );
+        CHECK( events[5].Volume == 64);
+        CHECK( events[7].EventType == SoundEvent::k_note_on );
+        CHECK( events[7].DeltaTime == 192L );
+        CHECK( events[7].Volume == 64);
+        CHECK( events[9].EventType == SoundEvent::k_note_on );
+        CHECK( events[9].DeltaTime == 256L );
+        CHECK( events[9].Volume == 64);
     }
 
     TEST_FIXTURE(MidiTableTestFixture, volume_002)
@@ -916,19 +959,19 @@ SUITE(MidiTableTest)
 //        cout << pTable->dump_midi_events() << endl;
         CHECK( pTable && check_num_events(pTable->num_events(), 11) );
         CHECK( pTable && pTable->get_anacrusis_missing_time() == 0.0 );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[2]->EventType == SoundEvent::k_note_on );
-        CHECK( events[2]->DeltaTime == 0L );
-        CHECK( events[2]->Volume == 85 );
-        CHECK( events[4]->EventType == SoundEvent::k_note_on );
-        CHECK( events[4]->DeltaTime == 64L );
-        CHECK( events[4]->Volume == 75 );
-        CHECK( events[6]->EventType == SoundEvent::k_note_on );
-        CHECK( events[6]->DeltaTime == 128L );
-        CHECK( events[6]->Volume == 75 );
-        CHECK( events[8]->EventType == SoundEvent::k_note_on );
-        CHECK( events[8]->DeltaTime == 192L );
-        CHECK( events[8]->Volume == 85 );
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[2].EventType == SoundEvent::k_note_on );
+        CHECK( events[2].DeltaTime == 0L );
+        CHECK( events[2].Volume == 85 );
+        CHECK( events[4].EventType == SoundEvent::k_note_on );
+        CHECK( events[4].DeltaTime == 64L );
+        CHECK( events[4].Volume == 75 );
+        CHECK( events[6].EventType == SoundEvent::k_note_on );
+        CHECK( events[6].DeltaTime == 128L );
+        CHECK( events[6].Volume == 75 );
+        CHECK( events[8].EventType == SoundEvent::k_note_on );
+        CHECK( events[8].DeltaTime == 192L );
+        CHECK( events[8].Volume == 85 );
     }
 
     TEST_FIXTURE(MidiTableTestFixture, volume_003)
@@ -947,22 +990,22 @@ SUITE(MidiTableTest)
 //        cout << pTable->dump_midi_events() << endl;
         CHECK( pTable && check_num_events(pTable->num_events(), 13) );
         CHECK( is_equal_time(pTable->get_anacrusis_missing_time(), 128.0 ) );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[2]->EventType == SoundEvent::k_note_on );
-        CHECK( events[2]->DeltaTime == 0L );
-        CHECK( events[2]->Volume == 75 );
-        CHECK( events[4]->EventType == SoundEvent::k_note_on );
-        CHECK( events[4]->DeltaTime == 64L );
-        CHECK( events[4]->Volume == 85 );
-        CHECK( events[6]->EventType == SoundEvent::k_note_on );
-        CHECK( events[6]->DeltaTime == 128L );
-        CHECK( events[6]->Volume == 75 );
-        CHECK( events[8]->EventType == SoundEvent::k_note_on );
-        CHECK( events[8]->DeltaTime == 192L );
-        CHECK( events[8]->Volume == 75 );
-        CHECK( events[10]->EventType == SoundEvent::k_note_on );
-        CHECK( events[10]->DeltaTime == 256L );
-        CHECK( events[10]->Volume == 85 );
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[2].EventType == SoundEvent::k_note_on );
+        CHECK( events[2].DeltaTime == 0L );
+        CHECK( events[2].Volume == 75 );
+        CHECK( events[4].EventType == SoundEvent::k_note_on );
+        CHECK( events[4].DeltaTime == 64L );
+        CHECK( events[4].Volume == 85 );
+        CHECK( events[6].EventType == SoundEvent::k_note_on );
+        CHECK( events[6].DeltaTime == 128L );
+        CHECK( events[6].Volume == 75 );
+        CHECK( events[8].EventType == SoundEvent::k_note_on );
+        CHECK( events[8].DeltaTime == 192L );
+        CHECK( events[8].Volume == 75 );
+        CHECK( events[10].EventType == SoundEvent::k_note_on );
+        CHECK( events[10].DeltaTime == 256L );
+        CHECK( events[10].Volume == 85 );
     }
 
 
@@ -998,14 +1041,14 @@ SUITE(MidiTableTest)
 //        cout << pTable->dump_midi_events() << endl;
         CHECK( pTable && check_num_events(pTable->num_events(), 5) );
         CHECK( pTable && pTable->get_anacrusis_missing_time() == 0.0 );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[0]->EventType == SoundEvent::k_prog_instr );
-        CHECK( events[0]->DeltaTime == 0L );
-        CHECK( events[1]->EventType == SoundEvent::k_rhythm_change );
-        CHECK( events[1]->DeltaTime == 0L );
-        CHECK( events[2]->EventType == SoundEvent::k_note_on );
-        CHECK( events[2]->DeltaTime == 0L );
-        CHECK( events[2]->NotePitch == 60);
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[0].EventType == SoundEvent::k_prog_instr );
+        CHECK( events[0].DeltaTime == 0L );
+        CHECK( events[1].EventType == SoundEvent::k_rhythm_change );
+        CHECK( events[1].DeltaTime == 0L );
+        CHECK( events[2].EventType == SoundEvent::k_note_on );
+        CHECK( events[2].DeltaTime == 0L );
+        CHECK( events[2].NotePitch == 60);
     }
 
     TEST_FIXTURE(MidiTableTestFixture, transpose_02)
@@ -1021,16 +1064,16 @@ SUITE(MidiTableTest)
 //        cout << pTable->dump_midi_events() << endl;
         CHECK( pTable && check_num_events(pTable->num_events(), 13) );
         CHECK( pTable && is_equal_time(pTable->get_anacrusis_missing_time(), 192.0) );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[6]->EventType == SoundEvent::k_note_on );
-        CHECK( events[6]->DeltaTime == 0L );
-        CHECK( events[6]->NotePitch == 60);
-        CHECK( events[7]->EventType == SoundEvent::k_note_on );
-        CHECK( events[7]->DeltaTime == 0L );
-        CHECK( events[7]->NotePitch == 60);
-        CHECK( events[8]->EventType == SoundEvent::k_note_on );
-        CHECK( events[8]->DeltaTime == 0L );
-        CHECK( events[8]->NotePitch == 60);
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[6].EventType == SoundEvent::k_note_on );
+        CHECK( events[6].DeltaTime == 0L );
+        CHECK( events[6].NotePitch == 60);
+        CHECK( events[7].EventType == SoundEvent::k_note_on );
+        CHECK( events[7].DeltaTime == 0L );
+        CHECK( events[7].NotePitch == 60);
+        CHECK( events[8].EventType == SoundEvent::k_note_on );
+        CHECK( events[8].DeltaTime == 0L );
+        CHECK( events[8].NotePitch == 60);
     }
 
     TEST_FIXTURE(MidiTableTestFixture, transpose_03)
@@ -1046,19 +1089,19 @@ SUITE(MidiTableTest)
 //        cout << pTable->dump_midi_events() << endl;
         CHECK( pTable && check_num_events(pTable->num_events(), 17) );
         CHECK( pTable && is_equal_time(pTable->get_anacrusis_missing_time(), 0.0) );
-        std::vector<SoundEvent*>& events = pTable->get_events();
-        CHECK( events[8]->EventType == SoundEvent::k_note_on );
-        CHECK( events[8]->DeltaTime == 0L );
-        CHECK( events[8]->NotePitch == 72);
-        CHECK( events[9]->EventType == SoundEvent::k_note_on );
-        CHECK( events[9]->DeltaTime == 0L );
-        CHECK( events[9]->NotePitch == 72);
-        CHECK( events[10]->EventType == SoundEvent::k_note_on );
-        CHECK( events[10]->DeltaTime == 0L );
-        CHECK( events[10]->NotePitch == 72);
-        CHECK( events[11]->EventType == SoundEvent::k_note_on );
-        CHECK( events[11]->DeltaTime == 0L );
-        CHECK( events[11]->NotePitch == 72);
+        std::vector<SoundEvent>& events = pTable->get_events();
+        CHECK( events[8].EventType == SoundEvent::k_note_on );
+        CHECK( events[8].DeltaTime == 0L );
+        CHECK( events[8].NotePitch == 72);
+        CHECK( events[9].EventType == SoundEvent::k_note_on );
+        CHECK( events[9].DeltaTime == 0L );
+        CHECK( events[9].NotePitch == 72);
+        CHECK( events[10].EventType == SoundEvent::k_note_on );
+        CHECK( events[10].DeltaTime == 0L );
+        CHECK( events[10].NotePitch == 72);
+        CHECK( events[11].EventType == SoundEvent::k_note_on );
+        CHECK( events[11].DeltaTime == 0L );
+        CHECK( events[11].NotePitch == 72);
     }
 
 
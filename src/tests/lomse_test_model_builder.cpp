@@ -73,6 +73,85 @@ SUITE(ModelBuilderTest)
         if (pRoot && !pRoot->is_document()) delete pRoot;
     }
 
+    TEST_FIXTURE(ModelBuilderTestFixture, build_model_only_modified_scores)
+    {
+        //@001. Only the modified scores are structurized again
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)(n c4 q)(barline))))"
+            "(score (vers 2.0)(instrument (musicData (clef F4)(n c3 q)(barline))))"
+            "))" );
+        ImoDocument* pImoDoc = doc.get_im_root();
+        ImoScore* pScore1 = static_cast<ImoScore*>( pImoDoc->get_content_item(0) );
+        ImoScore* pScore2 = static_cast<ImoScore*>( pImoDoc->get_content_item(1) );
+        CHECK( pScore1->is_structurized() == true );
+        CHECK( pScore2->is_structurized() == true );
+        ColStaffObjs* pTable1 = pScore1->get_staffobjs_table();
+        CHECK( pTable1->num_entries() == 3 );
+        CHECK( pScore2->get_staffobjs_table()->num_entries() == 3 );
+
+        ImoInstrument* pInstr = pScore2->get_instrument(0);
+        pInstr->add_object("(n e3 q)");
+
+        CHECK( pScore1->is_structurized() == true );
+        CHECK( pScore2->is_structurized() == false );
+
+        doc.end_of_changes();
+
+        CHECK( pScore1->is_structurized() == true );
+        CHECK( pScore2->is_structurized() == true );
+        CHECK( pScore1->get_staffobjs_table() == pTable1 );
+        CHECK( pScore2->get_staffobjs_table()->num_entries() == 4 );
+    }
+
+    TEST_FIXTURE(ModelBuilderTestFixture, build_model_several_scores)
+    {
+        //@002. Scores structurized together get the same result than when
+        //      structurized one by one
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)(key D)(time 2 4)"
+                "(n c4 q)(n +f4 q)(barline)(n f4 h)(barline))))"
+            "(score (vers 2.0)(instrument (staves 2)(musicData (clef G p1)(clef F4 p2)"
+                "(n c4 h p1)(goBack h)(n c3 h p2)(barline))))"
+            "(score (vers 2.0)(instrument (musicData (clef G)(n c4 e g+)(n d4 e g-)"
+                "(r q)(barline)))(instrument (musicData (clef F4)(n c3 h)(barline))))"
+            "(score (vers 2.0)(instrument (musicData (clef C3)(n -b3 q)(n b3 q)"
+                "(barline))))"
+            "))" );
+        ImoDocument* pImoDoc = doc.get_im_root();
+
+        for (int i=0; i < 4; ++i)
+        {
+            ImoScore* pScore = static_cast<ImoScore*>( pImoDoc->get_content_item(i) );
+            string built = pScore->get_staffobjs_table()->dump();
+            pScore->end_of_changes();
+            CHECK( pScore->get_staffobjs_table()->dump() == built );
+        }
+    }
+
+    TEST_FIXTURE(ModelBuilderTestFixture, build_model_all_scores_from_api)
+    {
+        //@003. ADocument::end_of_changes() structurizes all scores, as API setters
+        //      do not mark the modified objects as dirty
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData (clef G)(n c4 q)(barline))))"
+            "))" );
+        ImoScore* pScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        ColStaffObjs* pTable = pScore->get_staffobjs_table();
+
+        doc.end_of_changes();
+        CHECK( pScore->get_staffobjs_table() == pTable );
+
+        doc.get_document_api().end_of_changes();
+        CHECK( pScore->get_staffobjs_table() != pTable );
+        CHECK( pScore->is_structurized() == true );
+    }
+
 }
 
 
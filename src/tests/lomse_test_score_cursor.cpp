@@ -297,6 +297,25 @@ public:
         m_pScore = static_cast<ImoScore*>( m_pDoc->get_im_root()->get_content_item(0) );
     }
 
+    void create_document_10()
+    {
+        //time signature change in third measure
+        //(score (vers 2.0)(instrument (musicData
+        //(clef G)(time 6 8)(n c4 q.)(n e4 q.)(barline)
+        //(n g4 q.)(n c5 q.)(barline)
+        //(time 2 4)(n c4 q)(n e4 q)(barline)
+        //(n g4 q)(n c4 q)(barline) )))
+        m_pDoc = LOMSE_NEW Document(m_libraryScope);
+        m_pDoc->from_string("(lenmusdoc (vers 0.0) (content "
+            "(score (vers 2.0)(instrument (musicData "
+                "(clef G)(time 6 8)(n c4 q.)(n e4 q.)(barline)"
+                "(n g4 q.)(n c5 q.)(barline)"
+                "(time 2 4)(n c4 q)(n e4 q)(barline)"
+                "(n g4 q)(n c4 q)(barline) )))"
+            "))" );
+        m_pScore = static_cast<ImoScore*>( m_pDoc->get_im_root()->get_content_item(0) );
+    }
+
     void dump_col_staff_objs()
     {
         ColStaffObjs* pCol = m_pScore->get_staffobjs_table();
@@ -1664,6 +1683,44 @@ SUITE(ScoreCursorTest)
         //cout << cursor.dump_cursor();
     }
 
+    TEST_FIXTURE(ScoreCursorTestFixture, to_measure_327)
+    {
+        //327. to measure, time info uses time signature in previous measures
+        create_document_10();
+        MyScoreCursor cursor(m_pDoc, m_pScore);
+
+        cursor.to_measure(2, -1, -1);
+        TimeInfo info = cursor.get_time_info();
+        CHECK( is_equal_time(info.get_current_beat_duration(), 96.0) );
+        CHECK( is_equal_time(info.get_current_measure_start_timepos(), 384.0) );
+
+        cursor.to_measure(3, -1, -1);
+        info = cursor.get_time_info();
+        CHECK( is_equal_time(info.get_current_beat_duration(), 64.0) );
+        CHECK( is_equal_time(info.get_current_measure_start_timepos(), 512.0) );
+    }
+
+    TEST_FIXTURE(ScoreCursorTestFixture, to_time_328)
+    {
+        //328. to time, time info uses time signature in previous measures
+        create_document_10();
+        MyScoreCursor cursor(m_pDoc, m_pScore);
+
+        cursor.to_time(0, 0, 576.0);
+
+        CHECK( is_equal_time(cursor.time(), 576.0) );
+        TimeInfo info = cursor.get_time_info();
+        CHECK( is_equal_time(info.get_current_beat_duration(), 64.0) );
+        CHECK( is_equal_time(info.get_current_measure_start_timepos(), 512.0) );
+
+        cursor.to_time(0, 0, 96.0);
+
+        CHECK( is_equal_time(cursor.time(), 96.0) );
+        info = cursor.get_time_info();
+        CHECK( is_equal_time(info.get_current_beat_duration(), 96.0) );
+        CHECK( is_equal_time(info.get_current_measure_start_timepos(), 0.0) );
+    }
+
 //    TEST_FIXTURE(ScoreCursorTestFixture, next_note_in_chord_340)
 //    {
 //        //340. to_next_note_in_chord()
@@ -54,7 +54,7 @@ public:
         m_notifications.clear();
     }
 
-    //std::vector<SoundEvent*>& my_get_events() { return m_events; }
+    //std::vector<SoundEvent>& my_get_events() { return m_events; }
     SoundEventsTable* my_get_table() { return m_pTable; }
     bool my_play_segment_invoked() { return m_fPlaySegmentInvoked; }
     void my_do_play(int nEvStart, int nEvEnd, int UNUSED(playMode), bool fVisualTracking,
@@ -179,6 +179,29 @@ public:
     std::list<int>& my_get_events() { return m_events; }
 };
 
+//---------------------------------------------------------------------------------------
+//Helper, mock class saving the time at which sounds are requested
+class MyTimedMidiServer : public MidiServerBase
+{
+protected:
+    std::vector< std::chrono::steady_clock::time_point > m_times;
+    std::vector<int> m_numMessages;
+
+public:
+    MyTimedMidiServer() : MidiServerBase() {}
+    virtual ~MyTimedMidiServer() {}
+
+    //overrides
+    void send_messages(const std::vector<MidiMessage>& messages)
+    {
+        m_times.push_back( std::chrono::steady_clock::now() );
+        m_numMessages.push_back( int(messages.size()) );
+    }
+
+    std::vector< std::chrono::steady_clock::time_point >& my_get_times() { return m_times; }
+    std::vector<int>& my_get_num_messages() { return m_numMessages; }
+};
+
 //---------------------------------------------------------------------------------------
 class MyEventHandlerCPP2 : public EventHandler
 {
@@ -454,6 +477,77 @@ SUITE(ScorePlayerTest)
         CHECK( (*itN)->get_event_type() == k_end_of_playback_event );
     }
 
+    TEST_FIXTURE(ScorePlayerTestFixture, DoPlay_SoundsBatchedByTime)
+    {
+        SpDocument spDoc( new Document(m_libraryScope) );
+        spDoc->from_string("(lenmusdoc (vers 0.0) (content (score (vers 2.0) "
+            "(instrument (musicData (clef G)(chord (n c4 q)(n e4 q)(n g4 q))(n c4 q) )) )))" );
+        ImoScore* pScore = static_cast<ImoScore*>( spDoc->get_im_root()->get_content_item(0) );
+        MyTimedMidiServer midi;
+        MyScorePlayer player(m_libraryScope, &midi);
+        PlayerNoGui playGui;
+        player.load_score(pScore, &playGui);
+        int nEvMax = player.my_get_table()->num_events() - 1;
+        player.my_do_play(0, nEvMax, k_play_normal_instrument, k_no_visual_tracking,
+                          k_no_countoff, 600L, nullptr);
+        player.my_wait_for_termination();
+
+        //3 note on, 3 note off + 1 note on, 1 note off
+        std::vector<int>& batches = midi.my_get_num_messages();
+        CHECK( batches.size() == 3 );
+        CHECK( batches.size() == 3 && batches[0] == 3 );
+        CHECK( batches.size() == 3 && batches[1] == 4 );
+        CHECK( batches.size() == 3 && batches[2] == 1 );
+    }
+
+    TEST_FIXTURE(ScorePlayerTestFixture, DoPlay_NoDrift)
+    {
+        //a long score: 16 measures of sixteenths at 2400 BPM (6.25 ms each)
+        stringstream src;
+        src << "(lenmusdoc (vers 0.0) (content (score (vers 2.0) "
+            << "(instrument (musicData (clef G)(time 4 4)";
+        for (int i=0; i < 16; ++i)
+        {
+            for (int j=0; j < 4; ++j)
+                src << "(n c4 s)(n e4 s)(n g4 s)(n c5 s)";
+            src << "(barline)";
+        }
+        src << ")) )))";
+        SpDocument spDoc( new Document(m_libraryScope) );
+        spDoc->from_string(src.str());
+        ImoScore* pScore = static_cast<ImoScore*>( spDoc->get_im_root()->get_content_item(0) );
+        MyTimedMidiServer midi;
+        MyScorePlayer player(m_libraryScope, &midi);
+        PlayerNoGui playGui;
+        player.load_score(pScore, &playGui);
+        int nEvMax = player.my_get_table()->num_events() - 1;
+        player.my_do_play(0, nEvMax, k_play_normal_instrument, k_no_visual_tracking,
+                          k_no_countoff, 2400L, nullptr);
+        player.my_wait_for_termination();
+
+        //one batch per note start and a final batch. Total time: 64 beats * 25 ms.
+        //Each batch must be sent at its time, with an error not growing with time
+        std::vector< std::chrono::steady_clock::time_point >& times = midi.my_get_times();
+        CHECK( times.size() == 257 );
+        if (times.size() == 257)
+        {
+            long maxError = 0L;
+            for (int i=1; i < 257; ++i)
+            {
+                long expected = long(float(i * 16) * 25.0f / 64.0f);
+                long actual = long( std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        times[i] - times[0]).count() );
+                maxError = max(maxError, abs(actual - expected));
+            }
+            //cout << "max. error = " << maxError << " ms" << endl;
+            CHECK( maxError < 30L );
+        }
+
+        PlaybackJitter jitter = player.get_jitter_statistics();
+        CHECK( jitter.numTicks >= 256 );
+        CHECK( jitter.mean_delay() < 10000L );
+    }
+
     TEST_FIXTURE(ScorePlayerTestFixture, EndOfPlayEventReceived)
     {
         LomseDoorway* pLomse = m_libraryScope.platform_interface();
@@ -19,6 +19,7 @@
 #include "lomse_shape_note.h"
 #include "lomse_shape_staff.h"
 #include "lomse_glyphs.h"
+#include "lomse_calligrapher.h"
 #include "lomse_im_note.h"
 #include "lomse_note_engraver.h"
 #include "lomse_score_meter.h"
@@ -30,6 +31,16 @@ using namespace UnitTest;
 using namespace std;
 using namespace lomse;
 
+//---------------------------------------------------------------------------------------
+//helper, to access protected members
+class MyMusicGlyphs : public MusicGlyphs
+{
+public:
+    MyMusicGlyphs(LibraryScope* pLibScope) : MusicGlyphs(pLibScope) {}
+
+    size_t my_get_num_metrics() { return m_metrics.size(); }
+};
+
 //---------------------------------------------------------------------------------------
 class GmoShapeTestFixture
 {
@@ -74,6 +85,46 @@ SUITE(GmoShapeTest)
         CHECK( shape.get_origin() == newOrigin );
     }
 
+    TEST_FIXTURE(GmoShapeTestFixture, GlyphMetrics_SameAsTextMeter)
+    {
+        MusicGlyphs* pGlyphs = m_libraryScope.get_glyphs_table();
+        unsigned int glyph = pGlyphs->glyph_code(k_glyph_notehead_quarter);
+        GlyphMetrics metrics = pGlyphs->get_glyph_metrics(glyph, 21.0);
+
+        TextMeter meter(m_libraryScope);
+        meter.select_font("any",
+                          m_libraryScope.get_music_font_file(),
+                          m_libraryScope.get_music_font_name(),
+                          21.0);
+        URect bbox = meter.bounding_rectangle(glyph);
+        CHECK( metrics.bbox == bbox );
+        CHECK( metrics.advance == meter.get_advance_x(glyph) );
+
+        //cached value is returned for next requests
+        GlyphMetrics cached = pGlyphs->get_glyph_metrics(glyph, 21.0);
+        CHECK( cached.bbox == bbox );
+        CHECK( cached.advance == metrics.advance );
+
+        //metrics depend on font size
+        GlyphMetrics smaller = pGlyphs->get_glyph_metrics(glyph, 14.7);
+        CHECK( smaller.bbox.width < bbox.width );
+    }
+
+    TEST_FIXTURE(GmoShapeTestFixture, GlyphMetrics_DiscardedWhenFontsPathChanges)
+    {
+        MyMusicGlyphs glyphs(&m_libraryScope);
+        unsigned int glyph = glyphs.glyph_code(k_glyph_notehead_quarter);
+        glyphs.get_glyph_metrics(glyph, 21.0);
+        glyphs.get_glyph_metrics(glyph, 14.7);
+        CHECK( glyphs.my_get_num_metrics() == 2 );
+
+        m_libraryScope.set_default_fonts_path(TESTLIB_FONTS_PATH);
+        GlyphMetrics metrics = glyphs.get_glyph_metrics(glyph, 21.0);
+
+        CHECK( glyphs.my_get_num_metrics() == 1 );
+        CHECK( metrics.bbox.width > 0.0f );
+    }
+
     TEST_FIXTURE(GmoShapeTestFixture, Composite_RecomputeBounds)
     {
         Document doc(m_libraryScope);
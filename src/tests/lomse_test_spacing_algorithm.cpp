@@ -42,6 +42,7 @@ public:
     virtual ~MyScoreLayouter3() {}
 
     SpacingAlgorithm* get_spacing_algorithm() { return m_pSpAlgorithm; }
+    ScoreLayoutScope& my_get_scope() { return m_scoreLayoutScope; }
     void my_delete_all() { delete_not_used_objects(); }
 };
 
@@ -63,6 +64,32 @@ public:
     ColumnDataGourlay* my_get_column(int i) { return m_columns[i]; }
     list<TimeSlice*>& my_get_slices() { return m_slices; }
     vector<ShapeData*>& my_get_shapes_vector() { return m_shapes; }
+    LUnits my_get_minimum_width_for_line(int iFirstCol, int iLastCol) {
+        return determine_minimum_width_for_line(iFirstCol, iLastCol);
+    }
+};
+
+//---------------------------------------------------------------------------------------
+// helper, spacing algorithm with fixed penalties for the lines breaker
+class PenaltiesSpAlgGourlay : public SpAlgGourlay
+{
+protected:
+    vector< vector<float> > m_penalties;    //[iFirstCol][iLastCol]
+
+public:
+    PenaltiesSpAlgGourlay(ScoreLayoutScope& scope, const vector< vector<float> >& penalties)
+        : SpAlgGourlay(scope.get_library_scope(), scope.get_score_meter(),
+                       scope.get_score_layouter(), scope.get_score(),
+                       scope.get_engravers_map(), scope.get_shapes_creator(),
+                       scope.get_parts_engraver())
+        , m_penalties(penalties)
+    {
+    }
+    virtual ~PenaltiesSpAlgGourlay() {}
+
+    float determine_penalty_for_line(int UNUSED(iSystem), int i, int j) override {
+        return m_penalties[i][j];
+    }
 };
 
 //---------------------------------------------------------------------------------------
@@ -420,4 +447,75 @@ SUITE(SpAlgGourlayTest)
         scoreLyt.my_delete_all();
     }
 
+    TEST_FIXTURE(SpAlgGourlayTestFixture, SpAlgGourlay_06)
+    {
+        //@ 06. Minimum width for a line is the sum of its columns minimum width
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content (score (vers 2.0) "
+            "(instrument (musicData "
+            "(clef G)(key C)(time 2 4)"
+            "(n c4 q)(n e4 q)(barline)"
+            "(n g4 e)(n f4 e)(n e4 q)(barline)"
+            "(n d4 h)(barline)"
+            "(n c4 q)(r q)(barline)"
+            ")) )))" );
+        GraphicModel gmodel( doc.get_im_root() );
+        ImoScore* pImoScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        MyScoreLayouter3 scoreLyt(pImoScore, &gmodel, m_libraryScope);
+
+        scoreLyt.prepare_to_start_layout();     //this creates columns and do spacing
+        MySpAlgGourlay* pAlg = static_cast<MySpAlgGourlay*>(scoreLyt.get_spacing_algorithm());
+        CHECK( pAlg != nullptr );
+        int numCols = pAlg->get_num_columns();
+        CHECK( numCols == 4 );
+
+        for (int i=0; i < numCols; ++i)
+        {
+            LUnits width = 0.0f;
+            for (int j=i; j < numCols; ++j)
+            {
+                width += pAlg->my_get_column(j)->get_minimum_width();
+                CHECK( is_equal_pos(pAlg->my_get_minimum_width_for_line(i, j), width) );
+            }
+        }
+
+        scoreLyt.my_delete_all();
+    }
+
+    TEST_FIXTURE(SpAlgGourlayTestFixture, SpAlgGourlay_07)
+    {
+        //@ 07. Lines breaker: lines after a line that does not fit are still tried.
+        //@     Here the best option is a line {c0,...,c3} wider than the page, as
+        //@     system {c0} is worse than the 1000 penalty for the wider lines
+
+        Document doc(m_libraryScope);
+        doc.from_string("(lenmusdoc (vers 0.0) (content (score (vers 2.0) "
+            "(instrument (musicData "
+            "(clef G)(key C)(time 2 4)"
+            "(n c4 q)(n e4 q)(barline)"
+            "(n g4 e)(n f4 e)(n e4 q)(barline)"
+            "(n d4 h)(barline)"
+            "(n c4 q)(r q)(barline)"
+            ")) )))" );
+        GraphicModel gmodel( doc.get_im_root() );
+        ImoScore* pImoScore = static_cast<ImoScore*>( doc.get_im_root()->get_content_item(0) );
+        MyScoreLayouter3 scoreLyt(pImoScore, &gmodel, m_libraryScope);
+        scoreLyt.prepare_to_start_layout();
+        CHECK( scoreLyt.get_num_columns() == 4 );
+
+        vector< vector<float> > penalties(4, vector<float>(4, 0.0f));
+        penalties[0] = { 5000.0f, 1000.0f, 1000.0f, 1000.0f };
+        PenaltiesSpAlgGourlay alg(scoreLyt.my_get_scope(), penalties);
+        std::vector<int> breaks;
+        LinesBreakerOptimal breaker(&scoreLyt, m_libraryScope, &alg, breaks);
+
+        breaker.decide_line_breaks();
+
+        CHECK( breaks.size() == 1 );
+        CHECK( breaks[0] == 0 );
+
+        scoreLyt.my_delete_all();
+    }
+
 };
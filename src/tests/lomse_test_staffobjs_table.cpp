@@ -3669,3 +3669,85 @@ SUITE(ColStaffObjsBuilderTest)
 }
 
 
+
+
+//=======================================================================================
+// ColStaffObjs indexes tests
+//=======================================================================================
+SUITE(ColStaffObjsIndexTest)
+{
+
+    TEST_FIXTURE(ColStaffObjsBuilderTestFixture, index_01)
+    {
+        //@01. find entry by staffobj and by id
+        create_score(
+            "(score (vers 2.0)"
+            "(instrument (musicData "
+            "(clef G)(time 2 4)(n c4 q)(n e4 q)(barline)(n g4 h)(barline)"
+            ")))"
+        );
+        ColStaffObjsBuilder builder;
+        ColStaffObjs* pTable = builder.build(m_pScore);
+
+        for (ColStaffObjsIterator it = pTable->begin(); it != pTable->end(); ++it)
+        {
+            ImoStaffObj* pSO = (*it)->imo_object();
+            CHECK( pTable->find_entry_for(pSO) == *it );
+            CHECK( pTable->find_entry_for_id(pSO->get_id()) == *it );
+            CHECK( *(pTable->find(pSO)) == *it );
+        }
+        CHECK( pTable->find_entry_for_id(k_no_imoid) == nullptr );
+    }
+
+    TEST_FIXTURE(ColStaffObjsBuilderTestFixture, index_02)
+    {
+        //@02. deleted entries are removed from indexes
+        create_score(
+            "(score (vers 2.0)"
+            "(instrument (musicData "
+            "(clef G)(time 2 4)(n c4 q)(n e4 q)(barline)(n g4 h)(barline)"
+            ")))"
+        );
+        ColStaffObjsBuilder builder;
+        ColStaffObjs* pTable = builder.build(m_pScore);
+
+        ColStaffObjsIterator it = pTable->begin();
+        ++it;
+        ++it;
+        ImoStaffObj* pSO = (*it)->imo_object();     //(n c4 q)
+        ImoId id = pSO->get_id();
+        pTable->delete_entry_for(pSO);
+
+        CHECK( pTable->num_entries() == 6 );
+        CHECK( pTable->find_entry_for(pSO) == nullptr );
+        CHECK( pTable->find_entry_for_id(id) == nullptr );
+        CHECK( pTable->first_entry_in_measure(0)->to_string() == "(clef G p1)" );
+    }
+
+    TEST_FIXTURE(ColStaffObjsBuilderTestFixture, index_03)
+    {
+        //@03. first entry in measure
+        create_score(
+            "(score (vers 2.0)"
+            "(instrument (musicData "
+            "(clef G)(time 2 4)(n c4 q)(n e4 q)(barline)(n g4 h)(barline)"
+            "))"
+            "(instrument (musicData "
+            "(clef F4)(time 2 4)(n c3 h)(barline)(n e3 q)(n g3 q)(barline)"
+            ")))"
+        );
+        ColStaffObjsBuilder builder;
+        ColStaffObjs* pTable = builder.build(m_pScore);
+
+//        cout << test_name() << endl;
+//        cout << pTable->dump();
+        CHECK( pTable->num_measures() == 2 );
+        CHECK( pTable->first_entry_in_measure(0) == pTable->front() );
+        CHECK( pTable->first_entry_in_measure(1)->to_string() == "(n g4 h v1 p1)" );
+        CHECK( pTable->first_entry_in_measure(1, 0)->to_string() == "(clef F4 p1)" );
+        CHECK( pTable->first_entry_in_measure(1, 1)->to_string() == "(n e3 q v1 p1)" );
+        CHECK( pTable->first_entry_in_measure(2) == nullptr );
+        CHECK( pTable->first_entry_in_measure(2, 0) == nullptr );
+    }
+
+}
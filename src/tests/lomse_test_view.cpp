@@ -20,6 +20,9 @@
 #include "lomse_bitmap_drawer.h"
 #include "lomse_interactor.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace UnitTest;
 using namespace std;
 using namespace lomse;
@@ -551,6 +554,141 @@ SUITE(GraphicViewTest)
         rectangles.clear();
     }
 
+    //-- incremental repaint ------------------------------------------------------------
+
+    TEST_FIXTURE(GraphicViewTestFixture, scroll_reuses_rendered_bitmap)
+    {
+        MyDoorway platform;
+        LibraryScope libraryScope(cout, &platform);
+        SpDocument spDoc( new Document(libraryScope) );
+        spDoc->from_string("(lenmusdoc (vers 0.0) (content (score (vers 1.6) "
+            "(instrument (musicData (clef G)(key e)(n c4 q)(r q)(n e5 e)(n f4 e)"
+            "(barline simple))))))" );
+        VerticalBookView* pView = (VerticalBookView*)Injector::inject_View(libraryScope, k_view_vertical_book);
+        Interactor* pIntor = Injector::inject_Interactor(libraryScope, spDoc, pView, nullptr);
+        pView->set_interactor(pIntor);
+        const unsigned width = 300;
+        const unsigned height = 200;
+        std::vector<unsigned char> buf(width * height * 4);
+        pView->set_rendering_buffer(&buf[0], width, height);
+        pView->new_viewport(20, 40);
+        pView->redraw_bitmap();
+
+        //scroll, in both directions
+        pView->new_viewport(45, 10);
+        pView->redraw_bitmap();
+        std::vector<unsigned char> scrolled(buf);
+
+        //the result must be the same than when rendering all
+        pView->invalidate_background();
+        pView->redraw_bitmap();
+        int diffs = 0;
+        for (size_t i=0; i < buf.size(); ++i)
+        {
+            if (buf[i] != scrolled[i])
+                ++diffs;
+        }
+        CHECK( diffs == 0 );
+
+        delete pIntor;
+    }
+
+#if (LOMSE_ENABLE_THREADS == 1)
+    TEST_FIXTURE(GraphicViewTestFixture, render_documents_in_parallel)
+    {
+        //several documents can be rendered at the same time in different threads
+
+        MyDoorway platform;
+        LibraryScope libraryScope(cout, &platform);
+        const unsigned width = 300;
+        const unsigned height = 200;
+        auto render = [&libraryScope, width, height](std::vector<unsigned char>& buf)
+        {
+            SpDocument spDoc( new Document(libraryScope) );
+            spDoc->from_string("(lenmusdoc (vers 0.0) (content (score (vers 1.6) "
+                "(instrument (musicData (clef G)(key e)(time 3 4)(n c4 q)(r q)"
+                "(n e5 e)(n f4 e)(barline simple)(chord (n c4 h)(n e4 h))(n g4 q)"
+                "(barline end))))))" );
+            VerticalBookView* pView = (VerticalBookView*)Injector::inject_View(libraryScope, k_view_vertical_book);
+            Interactor* pIntor = Injector::inject_Interactor(libraryScope, spDoc, pView, nullptr);
+            pView->set_interactor(pIntor);
+            pView->set_rendering_buffer(&buf[0], width, height);
+            pView->new_viewport(20, 40);
+            pView->redraw_bitmap();
+            delete pIntor;
+        };
+
+        std::vector<unsigned char> expected(width * height * 4);
+        render(expected);
+
+        std::atomic<int> failures(0);
+        std::vector<std::thread> threads;
+        for (int t=0; t < 4; ++t)
+        {
+            threads.push_back( std::thread([&render, &expected, &failures, width, height]()
+            {
+                std::vector<unsigned char> buf(width * height * 4);
+                for (int i=0; i < 10; ++i)
+                {
+                    render(buf);
+                    if (buf != expected)
+                        ++failures;
+                }
+            }) );
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        CHECK( failures == 0 );
+    }
+
+    TEST_FIXTURE(GraphicViewTestFixture, print_pages_in_parallel)
+    {
+        //rendering pages in parallel produces the same result than printing them
+
+        MyDoorway platform;
+        LibraryScope libraryScope(cout, &platform);
+        stringstream src;
+        src << "(lenmusdoc (vers 0.0) (content (score (vers 1.6) "
+               "(instrument (musicData (clef G)(key e)(time 3 4)";
+        for (int i=0; i < 150; ++i)
+            src << "(n c4 q)(n e5 e)(n f4 e)(n g4 q)(barline simple)";
+        src << ")))))";
+        SpDocument spDoc( new Document(libraryScope) );
+        spDoc->from_string(src.str());
+        VerticalBookView* pView = (VerticalBookView*)Injector::inject_View(libraryScope, k_view_vertical_book);
+        Interactor* pIntor = Injector::inject_Interactor(libraryScope, spDoc, pView, nullptr);
+        pView->set_interactor(pIntor);
+
+        const unsigned width = 210;
+        const unsigned height = 297;
+        std::vector<unsigned char> print(width * height * 4);
+        pIntor->set_print_buffer(&print[0], width, height);
+        pIntor->set_print_page_size(width, height);
+        int numPages = pIntor->get_num_pages();
+        CHECK( numPages > 2 );
+
+        std::vector<int> pages;
+        std::vector< std::vector<unsigned char> > images(numPages);
+        std::vector<unsigned char*> buffers;
+        for (int i=0; i < numPages; ++i)
+        {
+            pages.push_back(i);
+            images[i].resize(width * height * 4);
+            buffers.push_back(&images[i][0]);
+        }
+        pIntor->print_pages(pages, buffers, width, height, VPoint(0, 0), 4);
+
+        for (int i=0; i < numPages; ++i)
+        {
+            pIntor->print_page(i);
+            CHECK( images[i] == print );
+        }
+
+        delete pIntor;
+    }
+#endif
+
     //TEST_FIXTURE(GraphicViewTestFixture, EditView_UpdateWindow)
     //{
     //    MyDoorway platform;